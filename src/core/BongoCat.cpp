@@ -1,5 +1,10 @@
 #include "core/BongoCat.h"
+#include "core/DirtyRegion.h"
+#include "core/FrameBatch.h"
+#include "core/LatencyTracer.h"
+#include "managers/TextureCache.h"
 #include "utils/Logger.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <vector>
@@ -12,6 +17,9 @@
 #endif
 
 bool BongoCat::loadHatTexture() {
+    atlasDirty = true; // Hat is baked into every pose
+    hatScaledTexture.reset(); // The hat sprite is always reset or recreated below
+    
     if (hatConfig.hatImage.empty() || hatConfig.folderPath.empty()) {
         hatSprite.reset();
         return false;
@@ -19,16 +27,19 @@ bool BongoCat::loadHatTexture() {
     
     std::string hatPath = hatConfig.getImagePath(hatConfig.hatImage);
     
-    if (!hatTexture.loadFromFile(hatPath)) {
+    std::shared_ptr<const sf::Texture> loadedHat = TextureCache::getInstance().load(hatPath);
+    if (!loadedHat) {
         hatSprite.reset();
         return false;
     }
     
-    // Create sprite and set up scaling
-    hatSprite = std::make_unique<sf::Sprite>(hatTexture);
+    // Create sprite and set up scaling (sprite must be replaced before the old texture can be released)
+    hatSprite = std::make_unique<sf::Sprite>(*loadedHat);
+    hatTexture = std::move(loadedHat);
+    hatImagePath = hatPath;
     
     // Get texture dimensions and apply scale
-    sf::Vector2u hatTexSize = hatTexture.getSize();
+    sf::Vector2u hatTexSize = hatTexture->getSize();
     if (hatTexSize.x > 0 && hatTexSize.y > 0) {
         // Scale based on cat size and hat config scale
         float baseScaleX = (size * 0.8f) / static_cast<float>(hatTexSize.x); // Hat is slightly smaller than body
@@ -41,6 +52,8 @@ bool BongoCat::loadHatTexture() {
         hatSprite->setScale(sf::Vector2f(finalScaleX, finalScaleY));
     }
     
+    usePrescaledTexture(*hatSprite, hatImagePath, hatScaledTexture);
+    
     updateHatPosition();
     return true;
 }
@@ -52,7 +65,7 @@ void BongoCat::updateHatPosition() {
     
     // Position hat relative to top of body (head area)
     sf::Vector2f bodyPos = bodySprite->getPosition(); // This is now the bottom center position
-    sf::Vector2u bodyTexSize = bodyTexture.getSize();
+    sf::Vector2u bodyTexSize = bodyTexture->getSize();
     
     // Calculate body dimensions
     float bodyDisplayWidth = size;
@@ -71,7 +84,7 @@ void BongoCat::updateHatPosition() {
     float hatY = bodyTopY + hatConfig.offsetY;
     
     // Adjust for hat sprite center if needed (hats typically center horizontally)
-    sf::Vector2u hatTexSize = hatTexture.getSize();
+    sf::Vector2u hatTexSize = hatTexture->getSize();
     if (hatTexSize.x > 0) {
         float hatWidth = (size * 0.8f) * hatConfig.scaleX;
         hatX -= hatWidth / 2.0f; // Center the hat horizontally
@@ -80,6 +93,50 @@ void BongoCat::updateHatPosition() {
     hatSprite->setPosition(sf::Vector2f(hatX, hatY));
 }
 
+bool BongoCat::loadTextureSet(const std::string& bodyPath, const std::string& handUpPath, const std::string& handDownPath) {
+    // Only replace the current textures once the whole set is available
+    TextureCache& cache = TextureCache::getInstance();
+    std::shared_ptr<const sf::Texture> body = cache.load(bodyPath);
+    std::shared_ptr<const sf::Texture> handUp = body ? cache.load(handUpPath) : nullptr;
+    std::shared_ptr<const sf::Texture> handDown = handUp ? cache.load(handDownPath) : nullptr;
+    if (!handDown) {
+        return false;
+    }
+    
+    // Callers recreate the sprites right after, before anything draws with the previous set
+    bodyTexture = std::move(body);
+    handUpTexture = std::move(handUp);
+    handDownTexture = std::move(handDown);
+    bodyImagePath = bodyPath;
+    handUpImagePath = handUpPath;
+    handDownImagePath = handDownPath;
+    return true;
+}
+
+void BongoCat::usePrescaledTexture(sf::Sprite& sprite, const std::string& imagePath, std::shared_ptr<const sf::Texture>& scaledTexture) {
+    // Swap the full resolution texture for one baked at the size it's displayed at, keeping
+    // the sprite's on-screen size and origin. Upscaled or unscaled sprites keep the original, and so
+    // does a sprite whose scaled texture is still being made (refreshScaledTextures() picks it up).
+    sf::Vector2u originalSize = sprite.getTexture().getSize();
+    sf::Vector2f scale = sprite.getScale();
+    sf::Vector2u displaySize(static_cast<unsigned int>(std::lround(originalSize.x * std::abs(scale.x))),
+                             static_cast<unsigned int>(std::lround(originalSize.y * std::abs(scale.y))));
+    
+    std::shared_ptr<const sf::Texture> scaled = TextureCache::getInstance().findScaled(imagePath, displaySize);
+    if (!scaled) {
+        scaledTexture.reset();
+        return;
+    }
+    
+    sf::Vector2f ratio(static_cast<float>(originalSize.x) / static_cast<float>(displaySize.x),
+                       static_cast<float>(originalSize.y) / static_cast<float>(displaySize.y));
+    sf::Vector2f origin = sprite.getOrigin();
+    sprite.setTexture(*scaled, true);
+    sprite.setOrigin(sf::Vector2f(origin.x / ratio.x, origin.y / ratio.y));
+    sprite.setScale(sf::Vector2f(scale.x * ratio.x, scale.y * ratio.y));
+    scaledTexture = std::move(scaled);
+}
+
 bool BongoCat::loadTextures() {
     bool loaded = false;
     
@@ -95,11 +152,7 @@ bool BongoCat::loadTextures() {
         LOG_INFO("  HandUp: " + handUpPath);
         LOG_INFO("  HandDown: " + handDownPath);
         
-        if (bodyTexture.loadFromFile(bodyPath) &&
-            handUpTexture.loadFromFile(handUpPath) &&
-            handDownTexture.loadFromFile(handDownPath)) {
-            loaded = true;
-        }
+        loaded = loadTextureSet(bodyPath, handUpPath, handDownPath);
     }
     
     // Fallback to default DevArt paths if config not available or failed
@@ -128,9 +181,7 @@ bool BongoCat::loadTextures() {
             std::string handUpPath = basePath + "handup-devartcat.png";
             std::string handDownPath = basePath + "handdown-devartcat.png";
             
-            if (bodyTexture.loadFromFile(bodyPath) &&
-                handUpTexture.loadFromFile(handUpPath) &&
-                handDownTexture.loadFromFile(handDownPath)) {
+            if (loadTextureSet(bodyPath, handUpPath, handDownPath)) {
                 LOG_INFO("[BongoCat] Successfully loaded default cat images from: " + basePath);
                 loaded = true;
                 break;
@@ -147,10 +198,10 @@ bool BongoCat::loadTextures() {
     }
     
     // Set up body sprite
-    bodySprite = std::make_unique<sf::Sprite>(bodyTexture);
+    bodySprite = std::make_unique<sf::Sprite>(*bodyTexture);
     
     // Get texture dimensions and scale to match desired size
-    sf::Vector2u bodyTexSize = bodyTexture.getSize();
+    sf::Vector2u bodyTexSize = bodyTexture->getSize();
     if (bodyTexSize.x > 0 && bodyTexSize.y > 0) {
         // Set origin to bottom center so sprite scales from bottom center
         bodySprite->setOrigin(sf::Vector2f(static_cast<float>(bodyTexSize.x) / 2.0f, static_cast<float>(bodyTexSize.y)));
@@ -164,7 +215,7 @@ bool BongoCat::loadTextures() {
     bodySprite->setPosition(sf::Vector2f(position.x + config.bodyOffsetX, position.y + config.bodyOffsetY));
     
     // Set up arm sprites
-    sf::Vector2u handTexSize = handUpTexture.getSize();
+    sf::Vector2u handTexSize = handUpTexture->getSize();
     if (handTexSize.x > 0 && handTexSize.y > 0) {
         // Use a proportion of the body size for arms (1.5x larger)
         armWidth = size * 0.3f * 1.5f;
@@ -178,8 +229,8 @@ bool BongoCat::loadTextures() {
         rightArmScale = sf::Vector2f(armScaleX, armScaleY);
         rightArmOrigin = sf::Vector2f(0.0f, 0.0f); // No origin offset needed since we're not flipping
         
-        leftArmSprite = std::make_unique<sf::Sprite>(handUpTexture);
-        rightArmSprite = std::make_unique<sf::Sprite>(handUpTexture);
+        leftArmSprite = std::make_unique<sf::Sprite>(*handUpTexture);
+        rightArmSprite = std::make_unique<sf::Sprite>(*handUpTexture);
         
         // Set origin to center horizontally and bottom vertically so arms flip around their center
         leftArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handTexSize.x) / 2.0f, static_cast<float>(handTexSize.y)));
@@ -189,21 +240,44 @@ bool BongoCat::loadTextures() {
         rightArmSprite->setScale(rightArmScale);
     } else {
         // Create sprites with hand up texture even if size is 0
-        leftArmSprite = std::make_unique<sf::Sprite>(handUpTexture);
-        rightArmSprite = std::make_unique<sf::Sprite>(handUpTexture);
+        leftArmSprite = std::make_unique<sf::Sprite>(*handUpTexture);
+        rightArmSprite = std::make_unique<sf::Sprite>(*handUpTexture);
         if (handTexSize.x > 0 && handTexSize.y > 0) {
             leftArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handTexSize.x) / 2.0f, static_cast<float>(handTexSize.y)));
             rightArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handTexSize.x) / 2.0f, static_cast<float>(handTexSize.y)));
         }
     }
     
+    // The punching arm keeps its own hand down sprite so poses never swap textures
+    punchArmSprite = std::make_unique<sf::Sprite>(*handDownTexture);
+    sf::Vector2u handDownTexSize = handDownTexture->getSize();
+    if (handDownTexSize.x > 0 && handDownTexSize.y > 0) {
+        punchArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handDownTexSize.x) / 2.0f, static_cast<float>(handDownTexSize.y)));
+    }
+    punchArmSprite->setScale(leftArmScale);
+    
+    // Sample textures baked at the displayed size rather than the full resolution images
+    usePrescaledTexture(*bodySprite, bodyImagePath, bodyScaledTexture);
+    usePrescaledTexture(*leftArmSprite, handUpImagePath, handUpScaledTexture);
+    usePrescaledTexture(*rightArmSprite, handUpImagePath, handUpScaledTexture);
+    usePrescaledTexture(*punchArmSprite, handDownImagePath, handDownScaledTexture);
+    
+    atlasDirty = true;
     return true;
 }
 
 BongoCat::BongoCat(float x, float y, float size, const CatPackConfig& config)
-    : position(x, y), size(size), config(config), hatConfig(), isPunching(false), punchTimer(0.0f), punchDuration(0.15f),
-      armWidth(size * 0.3f * 1.5f), armHeight(size * 0.4f * 1.5f), usingHandDownTexture(false), bodyDisplayHeight(size), windowHeight(200.0f),
-      leftArmActive(true), punchCount(0), isFlipped(false), leftArmOffsetX(0.0f), rightArmOffsetX(0.0f), animationVerticalOffset(0.0f) {
+    : position(x, y), size(size), config(config), hatConfig(),
+      bodyTexture(std::make_shared<sf::Texture>()), handUpTexture(std::make_shared<sf::Texture>()),
+      handDownTexture(std::make_shared<sf::Texture>()), hatTexture(std::make_shared<sf::Texture>()),
+      poseSlotSize(0, 0), atlasDirty(true), atlasReady(false),
+      isPunching(false), punchTimer(0.0f), punchDuration(0.15f),
+      previousPunchTimer(0.0f), renderPunchTimer(0.0f), tickAccumulator(0.0f),
+      simulationTime(std::chrono::steady_clock::now()), armRandom(std::random_device{}()),
+      leftArmActive(true), punchCount(0),
+      armWidth(size * 0.3f * 1.5f), armHeight(size * 0.4f * 1.5f), bodyDisplayHeight(size), windowHeight(200.0f),
+      isFlipped(false), leftArmOffsetX(0.0f), rightArmOffsetX(0.0f), animationVerticalOffset(0.0f),
+      rightArmSliderOffset(0.0f), animationVerticalSliderOffset(0.0f) {
     
     // Load textures
     bool texturesLoaded = loadTextures();
@@ -244,6 +318,10 @@ void BongoCat::setSize(float newSize) {
     armWidth = size * 0.3f * 1.5f;
     armHeight = size * 0.4f * 1.5f;
     
+    // The base offsets depend on the size; keep the user's slider values on top of the new ones
+    rightArmOffsetX = rightArmSliderOffset + getBaseRightArmOffset();
+    animationVerticalOffset = animationVerticalSliderOffset + getBaseAnimationVerticalOffset();
+    
     // Reload textures to update scales
     bool texturesLoaded = loadTextures();
     if (texturesLoaded) {
@@ -254,6 +332,16 @@ void BongoCat::setSize(float newSize) {
     }
 }
 
+void BongoCat::refreshScaledTextures() {
+    // Scaled textures that weren't ready when the sprites were set up are cached now
+    if (loadTextures()) {
+        recalculatePositions();
+        updateArmPositions();
+    }
+    loadHatTexture();
+    applyFlip();
+}
+
 void BongoCat::setFlip(bool flipped) {
     isFlipped = flipped;
     recalculatePositions(); // Recalculate positions to swap left/right when flipped
@@ -286,6 +374,7 @@ void BongoCat::setLeftArmOffset(float offsetX) {
 void BongoCat::setRightArmOffset(float offsetX) {
     // offsetX is the slider value (0 = base offset, user can adjust from there)
     // Add base offset for current size
+    rightArmSliderOffset = offsetX;
     rightArmOffsetX = offsetX + getBaseRightArmOffset();
     recalculatePositions();
     updateArmPositions();
@@ -294,6 +383,7 @@ void BongoCat::setRightArmOffset(float offsetX) {
 void BongoCat::setAnimationVerticalOffset(float offsetY) {
     // offsetY is the slider value (0 = base offset, user can adjust from there)
     // Add base offset for current size
+    animationVerticalSliderOffset = offsetY;
     animationVerticalOffset = offsetY + getBaseAnimationVerticalOffset();
     recalculatePositions();
     updateArmPositions();
@@ -331,6 +421,15 @@ void BongoCat::applyFlip() {
         }
     }
     
+    if (punchArmSprite) {
+        sf::Vector2f punchScale = punchArmSprite->getScale();
+        if (isFlipped) {
+            punchArmSprite->setScale(sf::Vector2f(-std::abs(punchScale.x), punchScale.y));
+        } else {
+            punchArmSprite->setScale(sf::Vector2f(std::abs(punchScale.x), punchScale.y));
+        }
+    }
+    
     // Also flip hat
     if (hatSprite) {
         sf::Vector2f hatScale = hatSprite->getScale();
@@ -340,11 +439,13 @@ void BongoCat::applyFlip() {
             hatSprite->setScale(sf::Vector2f(std::abs(hatScale.x), hatScale.y));
         }
     }
+    
+    atlasDirty = true;
 }
 
 void BongoCat::recalculatePositions() {
     // Calculate arm positions based on body position, size, and config offsets
-    sf::Vector2u bodyTexSize = bodyTexture.getSize();
+    sf::Vector2u bodyTexSize = bodyTexture->getSize();
     float bodyDisplayWidth = size;
     float bodyDisplayHeight = size;
     
@@ -425,46 +526,301 @@ void BongoCat::recalculatePositions() {
     
     // Update hat position when body position changes
     updateHatPosition();
+    
+    atlasDirty = true;
 }
 
 void BongoCat::update(float deltaTime) {
-    updateAnimation(deltaTime);
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration tick = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(TICK_SECONDS));
+    
+    tickAccumulator += deltaTime;
+    
+    // Where the simulation should be before this frame's ticks run. After an idle wait or a
+    // clamped hitch it lags real time; jump ahead rather than replaying the gap.
+    Clock::time_point expectedTime = Clock::now() - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(tickAccumulator));
+    if (expectedTime - simulationTime > std::chrono::milliseconds(100) || simulationTime - expectedTime > std::chrono::milliseconds(100)) {
+        simulationTime = expectedTime;
+    }
+    
+    std::vector<PendingPunch> punches;
+    {
+        std::lock_guard<std::mutex> lock(pendingPunchMutex);
+        punches.swap(pendingPunches);
+    }
+    size_t nextPunch = 0;
+    
+    while (tickAccumulator >= TICK_SECONDS) {
+        Clock::time_point tickEnd = simulationTime + tick;
+        previousPunchTimer = punchTimer;
+        
+        // Start every punch that happened during this tick (the last one wins, like repeated presses did)
+        while (nextPunch < punches.size() && punches[nextPunch].when < tickEnd) {
+            startPunch(punches[nextPunch].count);
+            LatencyTracer::getInstance().recordPoseChanged(punches[nextPunch].when);
+            nextPunch++;
+        }
+        
+        updateAnimation(TICK_SECONDS);
+        simulationTime = tickEnd;
+        tickAccumulator -= TICK_SECONDS;
+    }
+    
+    // Punches after the last whole tick wait for the next frame
+    if (nextPunch < punches.size()) {
+        std::lock_guard<std::mutex> lock(pendingPunchMutex);
+        pendingPunches.insert(pendingPunches.begin(), punches.begin() + nextPunch, punches.end());
+    }
+    
+    // Render between the last two ticks
+    float alpha = tickAccumulator / TICK_SECONDS;
+    renderPunchTimer = isPunching ? previousPunchTimer + (punchTimer - previousPunchTimer) * alpha : 0.0f;
+    updateArmPositions();
 }
 
-void BongoCat::draw(sf::RenderWindow& window) {
+void BongoCat::draw(sf::RenderTarget& target) {
+    const sf::Texture* texture = getAtlasTexture();
+    if (!texture) {
+        drawLayers(target);
+        return;
+    }
+    
+    FrameBatch batch;
+    batch.begin(texture, getAtlasSolidRect());
+    draw(batch);
+    batch.flush(target);
+}
+
+void BongoCat::draw(FrameBatch& batch) {
+    if (!atlasReady) {
+        return;
+    }
+    
+    Pose pose = POSE_REST;
+    if (isPunching) {
+        pose = leftArmActive ? POSE_LEFT_ACTIVE : POSE_RIGHT_ACTIVE;
+    }
+    
+    sf::Vector2f slotSize(static_cast<float>(poseSlotSize.x), static_cast<float>(poseSlotSize.y));
+    sf::Transform poseTransform;
+    poseTransform.translate(poseOrigin);
+    batch.addQuad(poseTransform, sf::FloatRect(sf::Vector2f(0.0f, 0.0f), slotSize),
+                  sf::FloatRect(sf::Vector2f(slotSize.x * pose, 0.0f), slotSize));
+    
+    if (pose != POSE_REST && punchArmSprite) {
+        batch.addQuad(punchArmSprite->getTransform(), punchArmSprite->getLocalBounds(), handDownAtlasRect);
+        
+        // Redraw anything that sits above the live arm in the layer order (body, left, right, hat)
+        // and overlaps it - rare, but keeps the result identical to drawing layer by layer
+        sf::FloatRect armBounds = punchArmSprite->getGlobalBounds();
+        if (pose == POSE_LEFT_ACTIVE && rightArmSprite && armBounds.findIntersection(rightArmSprite->getGlobalBounds())) {
+            batch.addQuad(rightArmSprite->getTransform(), rightArmSprite->getLocalBounds(), handUpAtlasRect);
+        }
+        if (hatSprite && armBounds.findIntersection(hatSprite->getGlobalBounds())) {
+            batch.addQuad(hatSprite->getTransform(), hatSprite->getLocalBounds(), hatAtlasRect);
+        }
+    }
+}
+
+const sf::Texture* BongoCat::getAtlasTexture() {
+    if (atlasDirty) {
+        rebuildAtlas();
+    }
+    return atlasReady ? &atlas.getTexture() : nullptr;
+}
+
+void BongoCat::drawLayers(sf::RenderTarget& target) {
     if (bodySprite) {
-        window.draw(*bodySprite);
+        target.draw(*bodySprite);
     }
+    bool leftPunching = isPunching && leftArmActive && punchArmSprite;
+    bool rightPunching = isPunching && !leftArmActive && punchArmSprite;
     if (leftArmSprite) {
-        window.draw(*leftArmSprite);
+        target.draw(leftPunching ? *punchArmSprite : *leftArmSprite);
     }
     if (rightArmSprite) {
-        window.draw(*rightArmSprite);
+        target.draw(rightPunching ? *punchArmSprite : *rightArmSprite);
     }
     // Draw hat last so it appears on top of everything
     if (hatSprite) {
-        window.draw(*hatSprite);
+        target.draw(*hatSprite);
+    }
+}
+
+sf::FloatRect BongoCat::getArmsBounds() const {
+    sf::FloatRect bounds;
+    
+    // Resting arms (left out of the pose while they punch)
+    if (leftArmSprite) {
+        bounds = unionRect(bounds, leftArmSprite->getGlobalBounds());
+    }
+    if (rightArmSprite) {
+        bounds = unionRect(bounds, rightArmSprite->getGlobalBounds());
+    }
+    
+    // The live arm anywhere between rest and punch on either side (moving it doesn't change its size)
+    if (punchArmSprite) {
+        sf::FloatRect armBounds = punchArmSprite->getGlobalBounds();
+        sf::Vector2f armPosition = punchArmSprite->getPosition();
+        sf::Vector2f handDownOffset(0.0f, config.handDownOffsetY);
+        for (const sf::Vector2f& target : {leftArmRestPos, leftArmPunchPos, rightArmRestPos, rightArmPunchPos}) {
+            bounds = unionRect(bounds, sf::FloatRect(armBounds.position + (target + handDownOffset - armPosition), armBounds.size));
+        }
+    }
+    
+    return bounds;
+}
+
+void BongoCat::rebuildAtlas() {
+    atlasDirty = false;
+    atlasReady = false;
+    
+    if (!bodySprite) {
+        return;
+    }
+    
+    // Resting arms are baked at their rest positions
+    if (leftArmSprite) {
+        leftArmSprite->setPosition(leftArmRestPos);
+    }
+    if (rightArmSprite) {
+        rightArmSprite->setPosition(rightArmRestPos);
+    }
+    
+    // Area covered by every layer of every pose
+    sf::FloatRect bounds = bodySprite->getGlobalBounds();
+    if (leftArmSprite) {
+        bounds = unionRect(bounds, leftArmSprite->getGlobalBounds());
+    }
+    if (rightArmSprite) {
+        bounds = unionRect(bounds, rightArmSprite->getGlobalBounds());
+    }
+    if (hatSprite) {
+        bounds = unionRect(bounds, hatSprite->getGlobalBounds());
+    }
+    
+    // Snap to whole pixels so the cached frame maps 1:1 onto the window
+    float left = std::floor(bounds.position.x);
+    float top = std::floor(bounds.position.y);
+    unsigned int slotWidth = static_cast<unsigned int>(std::ceil(bounds.position.x + bounds.size.x) - left);
+    unsigned int slotHeight = static_cast<unsigned int>(std::ceil(bounds.position.y + bounds.size.y) - top);
+    if (slotWidth == 0 || slotHeight == 0) {
+        return;
+    }
+    
+    // Layout: pose slots along the top row; the source images the live arm and overlap
+    // redraws sample, then a solid white block for UI shapes, along the second row.
+    // Regions are padded so neighbours never bleed into each other.
+    const unsigned int padding = 2;
+    const unsigned int solidSize = 4;
+    sf::Vector2u handUpSize = leftArmSprite ? leftArmSprite->getTexture().getSize() : sf::Vector2u(0, 0);
+    sf::Vector2u handDownSize = punchArmSprite ? punchArmSprite->getTexture().getSize() : sf::Vector2u(0, 0);
+    sf::Vector2u hatSize = hatSprite ? hatSprite->getTexture().getSize() : sf::Vector2u(0, 0);
+    
+    unsigned int rowY = slotHeight + padding;
+    unsigned int handUpX = 0;
+    unsigned int handDownX = handUpX + handUpSize.x + padding;
+    unsigned int hatX = handDownX + handDownSize.x + padding;
+    unsigned int solidX = hatX + hatSize.x + padding;
+    unsigned int rowHeight = std::max({handUpSize.y, handDownSize.y, hatSize.y, solidSize});
+    
+    sf::Vector2u atlasSize(std::max(slotWidth * POSE_COUNT, solidX + solidSize), rowY + rowHeight);
+    unsigned int maxSize = sf::Texture::getMaximumSize();
+    if (atlasSize.x > maxSize || atlasSize.y > maxSize) {
+        LOG_WARNING("[BongoCat] Pack images don't fit in one texture, drawing layers directly");
+        return;
     }
+    if (atlas.getSize() != atlasSize) {
+        if (!atlas.resize(atlasSize)) {
+            LOG_WARNING("[BongoCat] Failed to create texture atlas, drawing layers directly");
+            return;
+        }
+    }
+    
+    // Everything is composited onto transparent, which leaves premultiplied alpha in the atlas
+    atlas.clear(sf::Color::Transparent);
+    for (int pose = 0; pose < POSE_COUNT; pose++) {
+        sf::RenderStates states;
+        states.transform.translate(sf::Vector2f(static_cast<float>(slotWidth * pose) - left, -top));
+        
+        atlas.draw(*bodySprite, states);
+        if (leftArmSprite && pose != POSE_LEFT_ACTIVE) {
+            atlas.draw(*leftArmSprite, states);
+        }
+        if (rightArmSprite && pose != POSE_RIGHT_ACTIVE) {
+            atlas.draw(*rightArmSprite, states);
+        }
+        if (hatSprite) {
+            atlas.draw(*hatSprite, states);
+        }
+    }
+    
+    auto packImage = [this, rowY](const sf::Texture& texture, unsigned int x) {
+        sf::Sprite image(texture);
+        image.setPosition(sf::Vector2f(static_cast<float>(x), static_cast<float>(rowY)));
+        atlas.draw(image);
+        return sf::FloatRect(image.getPosition(), sf::Vector2f(texture.getSize()));
+    };
+    // Pack the textures the sprites actually sample (pre-scaled where available)
+    handUpAtlasRect = leftArmSprite ? packImage(leftArmSprite->getTexture(), handUpX) : sf::FloatRect();
+    handDownAtlasRect = punchArmSprite ? packImage(punchArmSprite->getTexture(), handDownX) : sf::FloatRect();
+    hatAtlasRect = hatSprite ? packImage(hatSprite->getTexture(), hatX) : sf::FloatRect();
+    
+    sf::RectangleShape solid(sf::Vector2f(static_cast<float>(solidSize), static_cast<float>(solidSize)));
+    solid.setPosition(sf::Vector2f(static_cast<float>(solidX), static_cast<float>(rowY)));
+    solid.setFillColor(sf::Color::White);
+    atlas.draw(solid);
+    solidAtlasRect = solid.getGlobalBounds();
+    
+    atlas.display();
+    
+    poseSlotSize = sf::Vector2u(slotWidth, slotHeight);
+    poseOrigin = sf::Vector2f(left, top);
+    atlasReady = true;
 }
 
 void BongoCat::punch() {
+    punch(std::chrono::steady_clock::now());
+}
+
+void BongoCat::punch(std::chrono::steady_clock::time_point when, int count) {
+    if (count <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pendingPunchMutex);
+    pendingPunches.push_back({when, count});
+}
+
+bool BongoCat::isAnimating() const {
+    if (isPunching) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(pendingPunchMutex);
+    return !pendingPunches.empty();
+}
+
+void BongoCat::setRandomSeed(std::uint32_t seed) {
+    armRandom.seed(seed);
+}
+
+void BongoCat::startPunch(int presses) {
     isPunching = true;
     punchTimer = 0.0f;
+    previousPunchTimer = 0.0f; // Interpolate up from the rest pose
     
-    // Alternate arms with some randomization
-    punchCount++;
-    
-    // Randomly decide to alternate or keep same arm (70% chance to alternate, 30% to keep same)
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+    // Randomly decide to alternate or keep same arm (70% chance to alternate, 30% to keep same).
+    // Presses batched into one punch each take their turn, so the arm ends up where it would have
+    // if every press had been its own punch
     std::uniform_real_distribution<float> dis(0.0f, 1.0f);
-    
-    float randVal = dis(gen);
-    if (randVal < 0.7f || punchCount == 1) {
-        // Alternate to the other arm
-        leftArmActive = !leftArmActive;
+    for (int i = 0; i < presses; i++) {
+        punchCount++;
+        float randVal = dis(armRandom);
+        if (randVal < 0.7f || punchCount == 1) {
+            // Alternate to the other arm
+            leftArmActive = !leftArmActive;
+        }
+        // Otherwise keep the same arm active
     }
-    // Otherwise keep the same arm active
 }
 
 void BongoCat::setPosition(float x, float y) {
@@ -501,125 +857,36 @@ void BongoCat::updateAnimation(float deltaTime) {
             punchTimer = 0.0f;
         }
     }
-    
-    updateArmPositions();
 }
 
 void BongoCat::updateArmPositions() {
-    float leftProgress = 0.0f;
-    float rightProgress = 0.0f;
+    float progress = 0.0f;
     
     if (isPunching) {
         // Ease in-out animation
-        float t = punchTimer / punchDuration;
-        float animProgress = t < 0.5f 
+        float t = std::min(renderPunchTimer / punchDuration, 1.0f);
+        progress = t < 0.5f 
             ? 2.0f * t * t 
             : 1.0f - std::pow(-2.0f * t + 2.0f, 2.0f) / 2.0f;
-        
-        // Only animate the active arm
-        if (leftArmActive) {
-            leftProgress = animProgress;
-            rightProgress = 0.0f; // Right arm stays at rest
-        } else {
-            leftProgress = 0.0f; // Left arm stays at rest
-            rightProgress = animProgress;
-        }
-        
-        // Use hand down texture for the active arm when punching
-        if (leftArmSprite && rightArmSprite) {
-            sf::Vector2u handUpTexSize = handUpTexture.getSize();
-            sf::Vector2u handDownTexSize = handDownTexture.getSize();
-            
-            // Only update if we weren't already using hand down texture or if we switched active arms
-            // Note: SFML 3.0 getTexture() returns a reference, so take address for comparison
-            if (!usingHandDownTexture || 
-                (leftArmActive && &leftArmSprite->getTexture() != &handDownTexture) ||
-                (!leftArmActive && &rightArmSprite->getTexture() != &handDownTexture)) {
-                
-                if (leftArmActive) {
-                    // Left arm is active - update left arm texture to hand down
-                    leftArmSprite->setTexture(handDownTexture, true);
-                    if (handDownTexSize.x > 0 && handDownTexSize.y > 0) {
-                        leftArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handDownTexSize.x) / 2.0f, static_cast<float>(handDownTexSize.y)));
-                    }
-                    leftArmSprite->setScale(leftArmScale);
-                    
-                    // Right arm stays with hand up texture
-                    rightArmSprite->setTexture(handUpTexture, true);
-                    if (handUpTexSize.x > 0 && handUpTexSize.y > 0) {
-                        rightArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handUpTexSize.x) / 2.0f, static_cast<float>(handUpTexSize.y)));
-                    }
-                    rightArmSprite->setScale(rightArmScale);
-                } else {
-                    // Right arm is active - update right arm texture to hand down
-                    rightArmSprite->setTexture(handDownTexture, true);
-                    if (handDownTexSize.x > 0 && handDownTexSize.y > 0) {
-                        rightArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handDownTexSize.x) / 2.0f, static_cast<float>(handDownTexSize.y)));
-                    }
-                    rightArmSprite->setScale(rightArmScale);
-                    
-                    // Left arm stays with hand up texture
-                    leftArmSprite->setTexture(handUpTexture, true);
-                    if (handUpTexSize.x > 0 && handUpTexSize.y > 0) {
-                        leftArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handUpTexSize.x) / 2.0f, static_cast<float>(handUpTexSize.y)));
-                    }
-                    leftArmSprite->setScale(leftArmScale);
-                }
-                usingHandDownTexture = true;
-                // Reapply flip after updating textures
-                applyFlip();
-            }
-        }
-    } else {
-        // Use hand up texture for both arms when idle
-        if (leftArmSprite && rightArmSprite && usingHandDownTexture) {
-            sf::Vector2u handTexSize = handUpTexture.getSize();
-            
-            leftArmSprite->setTexture(handUpTexture, true);
-            rightArmSprite->setTexture(handUpTexture, true);
-            
-            if (handTexSize.x > 0 && handTexSize.y > 0) {
-                leftArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handTexSize.x) / 2.0f, static_cast<float>(handTexSize.y)));
-                rightArmSprite->setOrigin(sf::Vector2f(static_cast<float>(handTexSize.x) / 2.0f, static_cast<float>(handTexSize.y)));
-            }
-            
-            leftArmSprite->setScale(leftArmScale);
-            rightArmSprite->setScale(rightArmScale);
-            
-            usingHandDownTexture = false;
-            // Reapply flip after updating textures
-            applyFlip();
-        }
-    }
-    
-    // Interpolate between rest and punch positions (only active arm moves)
-    sf::Vector2f leftPos = sf::Vector2f(
-        leftArmRestPos.x + (leftArmPunchPos.x - leftArmRestPos.x) * leftProgress,
-        leftArmRestPos.y + (leftArmPunchPos.y - leftArmRestPos.y) * leftProgress
-    );
-    
-    sf::Vector2f rightPos = sf::Vector2f(
-        rightArmRestPos.x + (rightArmPunchPos.x - rightArmRestPos.x) * rightProgress,
-        rightArmRestPos.y + (rightArmPunchPos.y - rightArmRestPos.y) * rightProgress
-    );
-    
-    // Apply hand down offset when using hand down texture
-    if (usingHandDownTexture) {
-        if (leftArmActive) {
-            leftPos.y += config.handDownOffsetY;
-        } else {
-            rightPos.y += config.handDownOffsetY;
-        }
     }
     
+    // Resting arms never move (they're baked into the pose cache)
     if (leftArmSprite) {
-        leftArmSprite->setPosition(leftPos);
+        leftArmSprite->setPosition(leftArmRestPos);
     }
     if (rightArmSprite) {
-        rightArmSprite->setPosition(rightPos);
+        rightArmSprite->setPosition(rightArmRestPos);
     }
     
-    // Always re-apply flip state because setScale above might have reset it (if we used setScale with positive values)
-    applyFlip();
+    // Only the active arm animates: interpolate between rest and punch positions,
+    // with the hand down offset applied since it uses the hand down texture
+    if (punchArmSprite) {
+        const sf::Vector2f& restPos = leftArmActive ? leftArmRestPos : rightArmRestPos;
+        const sf::Vector2f& punchPos = leftArmActive ? leftArmPunchPos : rightArmPunchPos;
+        sf::Vector2f punchArmPos(
+            restPos.x + (punchPos.x - restPos.x) * progress,
+            restPos.y + (punchPos.y - restPos.y) * progress + config.handDownOffsetY
+        );
+        punchArmSprite->setPosition(punchArmPos);
+    }
 }
-
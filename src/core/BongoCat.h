@@ -1,17 +1,32 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
 #include "config/CatPackConfig.h"
 #include "config/HatConfig.h"
 
+class FrameBatch;
+
 class BongoCat {
 public:
     BongoCat(float x, float y, float size, const CatPackConfig& config = CatPackConfig());
     
     void update(float deltaTime);
-    void draw(sf::RenderWindow& window);
-    void punch();
+    void draw(sf::RenderTarget& target);
+    void draw(FrameBatch& batch); // Append the cat to a batch opened on getAtlasTexture()
+    const sf::Texture* getAtlasTexture(); // Shared texture for batching, nullptr if unavailable
+    sf::FloatRect getAtlasSolidRect() const { return solidAtlasRect; } // Opaque white area for untextured shapes
+    void punch(); // Punch now
+    void punch(std::chrono::steady_clock::time_point when, int count = 1); // Punch at the simulation tick containing when, for count presses
+    bool isAnimating() const; // True while a punch animation is running or waiting for its tick
+    void setRandomSeed(std::uint32_t seed); // Make arm alternation reproducible (benchmarks, replays)
+    bool isLayoutDirty() const { return atlasDirty; } // Pack/size/offset/flip/hat changed since the last draw
+    sf::FloatRect getArmsBounds() const; // Everything a punch animation can touch
     
     void setPosition(float x, float y);
     sf::Vector2f getPosition() const;
@@ -21,6 +36,7 @@ public:
     void setConfig(const CatPackConfig& config); // Change cat pack configuration
     void setHat(const HatConfig& hat); // Change hat configuration
     void setSize(float newSize); // Change cat size
+    void refreshScaledTextures(); // Set the sprites up again once TextureCache::uploadScaled() added textures
     void setFlip(bool flipped); // Flip cat horizontally (mirror on vertical line)
     void setLeftArmOffset(float offsetX); // Adjust left arm horizontal offset (negative = left, positive = right)
     void setRightArmOffset(float offsetX); // Adjust right arm horizontal offset (negative = left, positive = right) - 0 means base offset for size
@@ -37,22 +53,66 @@ private:
     CatPackConfig config; // Cat pack configuration
     HatConfig hatConfig; // Hat configuration
     
-    // Textures for images
-    sf::Texture bodyTexture;
-    sf::Texture handUpTexture;
-    sf::Texture handDownTexture;
-    sf::Texture hatTexture;
+    // Textures for images (shared through TextureCache; empty until a pack loads)
+    std::shared_ptr<const sf::Texture> bodyTexture;
+    std::shared_ptr<const sf::Texture> handUpTexture;
+    std::shared_ptr<const sf::Texture> handDownTexture;
+    std::shared_ptr<const sf::Texture> hatTexture;
+    
+    // Versions pre-scaled to the displayed size, which the sprites sample when available
+    std::shared_ptr<const sf::Texture> bodyScaledTexture;
+    std::shared_ptr<const sf::Texture> handUpScaledTexture;
+    std::shared_ptr<const sf::Texture> handDownScaledTexture;
+    std::shared_ptr<const sf::Texture> hatScaledTexture;
+    std::string bodyImagePath;
+    std::string handUpImagePath;
+    std::string handDownImagePath;
+    std::string hatImagePath;
     
     // Sprites for rendering (using pointers for SFML 3.0 compatibility)
     std::unique_ptr<sf::Sprite> bodySprite;
-    std::unique_ptr<sf::Sprite> leftArmSprite;
-    std::unique_ptr<sf::Sprite> rightArmSprite;
+    std::unique_ptr<sf::Sprite> leftArmSprite; // Hand up, always at rest position
+    std::unique_ptr<sf::Sprite> rightArmSprite; // Hand up, always at rest position
+    std::unique_ptr<sf::Sprite> punchArmSprite; // Hand down, drawn over the pose for the active arm
     std::unique_ptr<sf::Sprite> hatSprite;
     
-    // Animation state
+    // Texture atlas rebuilt on config/size/offset/flip/hat change. The top row holds pre-rendered
+    // pose frames (body, resting arms and hat composited), the second row the hand and hat images
+    // and a solid white block, so the cat and the UI shapes draw from one texture in one batch.
+    enum Pose {
+        POSE_REST = 0,         // Both arms up
+        POSE_LEFT_ACTIVE = 1,  // Left arm left out (drawn live)
+        POSE_RIGHT_ACTIVE = 2, // Right arm left out (drawn live)
+        POSE_COUNT = 3
+    };
+    sf::RenderTexture atlas;
+    sf::Vector2u poseSlotSize;
+    sf::Vector2f poseOrigin; // Window position of a pose slot's top-left corner
+    sf::FloatRect handUpAtlasRect;
+    sf::FloatRect handDownAtlasRect;
+    sf::FloatRect hatAtlasRect;
+    sf::FloatRect solidAtlasRect;
+    bool atlasDirty;
+    bool atlasReady; // False if the atlas couldn't be created (layers are drawn directly)
+    
+    // Animation state, advanced in fixed ticks of TICK_SECONDS
+    static constexpr float TICK_SECONDS = 1.0f / 240.0f;
     bool isPunching;
     float punchTimer;
     float punchDuration;
+    float previousPunchTimer; // punchTimer at the previous tick, for render interpolation
+    float renderPunchTimer;   // Interpolated between ticks at the current frame
+    float tickAccumulator;    // Frame time not yet simulated
+    std::chrono::steady_clock::time_point simulationTime; // Time of the last simulated tick
+    
+    // Punches waiting for the tick that contains their timestamp
+    struct PendingPunch {
+        std::chrono::steady_clock::time_point when;
+        int count; // Presses batched into this punch
+    };
+    std::vector<PendingPunch> pendingPunches;
+    mutable std::mutex pendingPunchMutex;
+    std::mt19937 armRandom;
     
     // Arm alternation state
     bool leftArmActive; // true if left arm is currently active, false for right arm
@@ -79,9 +139,6 @@ private:
     sf::Vector2f rightArmScale;
     sf::Vector2f rightArmOrigin;
     
-    // Track current texture state to avoid unnecessary sprite recreation
-    bool usingHandDownTexture;
-    
     // Flip state
     bool isFlipped;
     
@@ -89,13 +146,20 @@ private:
     float leftArmOffsetX;
     float rightArmOffsetX;
     float animationVerticalOffset;
+    float rightArmSliderOffset; // Slider values, re-based on the size-specific base when the size changes
+    float animationVerticalSliderOffset;
     
-    void updateAnimation(float deltaTime);
+    void updateAnimation(float deltaTime); // Advance one simulation tick
+    void startPunch(int presses);
     void updateArmPositions();
     bool loadTextures();
+    bool loadTextureSet(const std::string& bodyPath, const std::string& handUpPath, const std::string& handDownPath); // All or nothing
     bool loadHatTexture(); // Load hat texture
+    void usePrescaledTexture(sf::Sprite& sprite, const std::string& imagePath, std::shared_ptr<const sf::Texture>& scaledTexture);
     void recalculatePositions(); // Recalculate positions when config changes
     void updateHatPosition(); // Update hat position relative to body
     void applyFlip(); // Apply flip state to sprites
+    void rebuildAtlas(); // Composite poses and pack images into the atlas
+    void drawLayers(sf::RenderTarget& target); // Direct drawing, used if the pose cache is unavailable
 };
 
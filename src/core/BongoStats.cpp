@@ -12,6 +12,9 @@
 
 #ifdef _WIN32
 #include <windows.h>
+#else
+#include "platform/VirtualKeyCodes.h"
+using namespace VirtualKey;
 #endif
 
 void BongoStats::initialize(const std::string& baseDataDir) {
@@ -50,6 +53,36 @@ void BongoStats::recordMouseClick(const std::string& buttonName) {
     mouseButtonCounts[buttonName]++;
 }
 
+void BongoStats::recordKeyPresses(const std::vector<unsigned int>& keyCodes) {
+    if (keyCodes.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(statsMutex);
+    time_t now = std::time(nullptr);
+    for (unsigned int keyCode : keyCodes) {
+        keyPressCounts[keyCode]++;
+        keyPressTimestamps.push_back(now);
+    }
+    
+    // Keep only last 1000 timestamps to avoid memory issues
+    if (keyPressTimestamps.size() > 1000) {
+        keyPressTimestamps.erase(keyPressTimestamps.begin(), keyPressTimestamps.end() - 1000);
+    }
+    
+    if (firstKeyPressTime == 0) {
+        firstKeyPressTime = now;
+    }
+    lastKeyPressTime = now;
+}
+
+void BongoStats::recordMouseClicks(const std::string& buttonName, int count) {
+    if (count <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(statsMutex);
+    mouseButtonCounts[buttonName] += count;
+}
+
 int BongoStats::getKeyCount(unsigned int keyCode) const {
     std::lock_guard<std::mutex> lock(statsMutex);
     auto it = keyPressCounts.find(keyCode);
@@ -102,8 +135,7 @@ void BongoStats::ensureYearFolderExists(int year) const {
 }
 
 std::string BongoStats::getKeyName(unsigned int keyCode) const {
-#ifdef _WIN32
-    // Windows virtual key codes
+    // Windows virtual key codes (hooks on other platforms translate to these)
     switch (keyCode) {
         case VK_SPACE: return "SPACE";
         case VK_RETURN: return "ENTER";
@@ -155,10 +187,6 @@ std::string BongoStats::getKeyName(unsigned int keyCode) const {
             }
             return "KEY_" + std::to_string(keyCode);
     }
-#else
-    // For non-Windows, just return the code as string
-    return "KEY_" + std::to_string(keyCode);
-#endif
 }
 
 std::string BongoStats::formatStats() const {
@@ -23,6 +23,10 @@ public:
     // Record a mouse button click
     void recordMouseClick(const std::string& buttonName); // "LEFT", "RIGHT", "MIDDLE"
     
+    // Record a frame's worth of input at once (one lock and one timestamp per batch)
+    void recordKeyPresses(const std::vector<unsigned int>& keyCodes);
+    void recordMouseClicks(const std::string& buttonName, int count);
+    
     // Save stats to file
     void saveStats();
     
@@ -0,0 +1,37 @@
+#include "core/DirtyRegion.h"
+#include <algorithm>
+
+DirtyRegion::DirtyRegion()
+    : empty(true), full(false) {
+}
+
+void DirtyRegion::add(const sf::FloatRect& rect) {
+    if (full || rect.size.x <= 0.0f || rect.size.y <= 0.0f) {
+        return;
+    }
+    bounds = empty ? rect : unionRect(bounds, rect);
+    empty = false;
+}
+
+void DirtyRegion::addAll() {
+    full = true;
+}
+
+void DirtyRegion::clear() {
+    empty = true;
+    full = false;
+}
+
+sf::FloatRect unionRect(const sf::FloatRect& a, const sf::FloatRect& b) {
+    if (a.size.x <= 0.0f || a.size.y <= 0.0f) {
+        return b;
+    }
+    if (b.size.x <= 0.0f || b.size.y <= 0.0f) {
+        return a;
+    }
+    float left = std::min(a.position.x, b.position.x);
+    float top = std::min(a.position.y, b.position.y);
+    float right = std::max(a.position.x + a.size.x, b.position.x + b.size.x);
+    float bottom = std::max(a.position.y + a.size.y, b.position.y + b.size.y);
+    return sf::FloatRect(sf::Vector2f(left, top), sf::Vector2f(right - left, bottom - top));
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+// Accumulates the part of the window that changed since the last presented frame,
+// as a single bounding rectangle, so frames where nothing visible changed are skipped.
+class DirtyRegion {
+public:
+    DirtyRegion();
+    
+    void add(const sf::FloatRect& rect);
+    void addAll(); // Everything changed (layout change, window event, first frame)
+    void clear();
+    
+    bool isEmpty() const { return !full && empty; }
+    bool isFull() const { return full; }
+    
+private:
+    sf::FloatRect bounds;
+    bool empty;
+    bool full;
+};
+
+// Smallest rectangle containing both; a rectangle with no area counts as empty and is left out
+sf::FloatRect unionRect(const sf::FloatRect& a, const sf::FloatRect& b);
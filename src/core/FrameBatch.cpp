@@ -0,0 +1,72 @@
+#include "core/FrameBatch.h"
+#include <cstdint>
+
+namespace {
+    // Atlas texels are premultiplied, so the source color is already scaled by its alpha
+    const sf::BlendMode PREMULTIPLIED_ALPHA(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha);
+    
+    sf::Color premultiply(sf::Color color) {
+        return sf::Color(
+            static_cast<std::uint8_t>(color.r * color.a / 255),
+            static_cast<std::uint8_t>(color.g * color.a / 255),
+            static_cast<std::uint8_t>(color.b * color.a / 255),
+            color.a
+        );
+    }
+}
+
+FrameBatch::FrameBatch()
+    : vertices(sf::PrimitiveType::Triangles), texture(nullptr), solidTexCoords(0.0f, 0.0f) {
+}
+
+void FrameBatch::begin(const sf::Texture* newTexture, const sf::FloatRect& solidRect) {
+    texture = newTexture;
+    solidTexCoords = solidRect.getCenter();
+    vertices.clear();
+}
+
+void FrameBatch::addQuad(const sf::Transform& transform, const sf::FloatRect& localRect, const sf::FloatRect& textureRect,
+                         sf::Color color) {
+    const sf::Vector2f localCorners[4] = {
+        localRect.position,
+        sf::Vector2f(localRect.position.x + localRect.size.x, localRect.position.y),
+        sf::Vector2f(localRect.position.x, localRect.position.y + localRect.size.y),
+        localRect.position + localRect.size
+    };
+    const sf::Vector2f texCorners[4] = {
+        textureRect.position,
+        sf::Vector2f(textureRect.position.x + textureRect.size.x, textureRect.position.y),
+        sf::Vector2f(textureRect.position.x, textureRect.position.y + textureRect.size.y),
+        textureRect.position + textureRect.size
+    };
+    
+    sf::Color vertexColor = premultiply(color);
+    sf::Vertex corners[4];
+    for (int i = 0; i < 4; i++) {
+        corners[i] = sf::Vertex{transform.transformPoint(localCorners[i]), vertexColor, texCorners[i]};
+    }
+    
+    // Two triangles per quad
+    vertices.append(corners[0]);
+    vertices.append(corners[1]);
+    vertices.append(corners[2]);
+    vertices.append(corners[2]);
+    vertices.append(corners[1]);
+    vertices.append(corners[3]);
+}
+
+void FrameBatch::addRectangle(const sf::RectangleShape& shape) {
+    addQuad(shape.getTransform(), sf::FloatRect(sf::Vector2f(0.0f, 0.0f), shape.getSize()),
+            sf::FloatRect(solidTexCoords, sf::Vector2f(0.0f, 0.0f)), shape.getFillColor());
+}
+
+void FrameBatch::flush(sf::RenderTarget& target) {
+    if (!texture || vertices.getVertexCount() == 0) {
+        return;
+    }
+    
+    sf::RenderStates states(PREMULTIPLIED_ALPHA);
+    states.texture = texture;
+    target.draw(vertices, states);
+    vertices.clear();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+// Collects quads that sample one texture into a single vertex array, so the cat,
+// its hat and the UI shapes reach the GPU as one draw call with one texture bind.
+// Texels are expected to be premultiplied by alpha (as produced by compositing onto
+// a transparent render texture), and untextured shapes sample a solid white texel.
+class FrameBatch {
+public:
+    FrameBatch();
+    
+    // Start a batch sampling texture; solidRect is an opaque white area of that texture
+    void begin(const sf::Texture* texture, const sf::FloatRect& solidRect);
+    
+    // Queue a textured quad: localRect is transformed into window space, textureRect is in pixels
+    void addQuad(const sf::Transform& transform, const sf::FloatRect& localRect, const sf::FloatRect& textureRect,
+                 sf::Color color = sf::Color::White);
+    
+    // Queue a filled rectangle shape (outlines aren't supported, the UI doesn't use them)
+    void addRectangle(const sf::RectangleShape& shape);
+    
+    // Draw everything queued so far in one call; the batch stays open for more quads
+    void flush(sf::RenderTarget& target);
+    
+    bool isOpen() const { return texture != nullptr; }
+    
+private:
+    sf::VertexArray vertices;
+    const sf::Texture* texture;
+    sf::Vector2f solidTexCoords; // Center of the solid texel area
+};
@@ -0,0 +1,145 @@
+#include "core/FramePacer.h"
+#include "core/RenderScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+namespace {
+    // Bounds on the time before the deadline at which we stop sleeping and start spinning.
+    // The margin itself follows the oversleep actually measured (see adaptSpinMargin).
+    constexpr auto MIN_SPIN_MARGIN = std::chrono::microseconds(200);
+    constexpr auto INITIAL_SPIN_MARGIN = std::chrono::microseconds(500);
+    constexpr auto MAX_SPIN_MARGIN = std::chrono::microseconds(2000);
+
+    // Largest frame delta handed to the animation, so a hitch slows a punch down instead of skipping it
+    constexpr float MAX_FRAME_DELTA = 0.05f;
+
+    std::chrono::steady_clock::duration intervalForProfile(FramePacer::Profile profile) {
+        switch (profile) {
+            case FramePacer::Profile::Animating: return std::chrono::nanoseconds(1000000000LL / 144);
+            case FramePacer::Profile::Interactive: return std::chrono::nanoseconds(1000000000LL / 60);
+            case FramePacer::Profile::Idle: return std::chrono::nanoseconds(1000000000LL / 10);
+        }
+        return std::chrono::nanoseconds(1000000000LL / 60);
+    }
+}
+
+FramePacer::FramePacer()
+    : profile(Profile::Idle), frameInterval(intervalForProfile(Profile::Idle)),
+      frameStart(Clock::now()), lastFrameStart(Clock::now()), highResolutionTimer(false),
+      spinMargin(INITIAL_SPIN_MARGIN), oversleep(Clock::duration::zero()),
+      jitterSamples{}, jitterSampleCount(0), jitterSampleIndex(0) {
+}
+
+FramePacer::~FramePacer() {
+    setHighResolutionTimer(false);
+}
+
+void FramePacer::setProfile(Profile newProfile) {
+    if (newProfile == profile) {
+        return;
+    }
+    profile = newProfile;
+    frameInterval = intervalForProfile(profile);
+
+    // Only pay for the 1 ms system timer while frames are actually being paced tightly
+    setHighResolutionTimer(profile != Profile::Idle);
+}
+
+float FramePacer::beginFrame() {
+    lastFrameStart = frameStart;
+    frameStart = Clock::now();
+
+    float deltaTime = std::chrono::duration<float>(frameStart - lastFrameStart).count();
+    return std::min(deltaTime, MAX_FRAME_DELTA);
+}
+
+void FramePacer::endFrame(RenderScheduler& scheduler) {
+    const Clock::time_point deadline = frameStart + frameInterval;
+
+    // Sleep phase: block until just before the deadline, waking early for new work
+    Clock::time_point now = Clock::now();
+    const Clock::time_point wakeTarget = deadline - spinMargin;
+    // Waits are whole milliseconds. Rounding to the nearest one keeps the spin short, and any
+    // overshoot it causes is measured below and widens the margin
+    auto sleepTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+        wakeTarget - now + std::chrono::microseconds(500));
+    if (sleepTime.count() > 0) {
+        if (scheduler.waitForWork(sleepTime)) {
+            // Input arrived - handle it now rather than finishing the frame budget
+            return;
+        }
+        now = Clock::now();
+        adaptSpinMargin(now - wakeTarget);
+    }
+
+    // Spin phase: precise wait for the remainder
+    while (now < deadline) {
+        std::this_thread::yield();
+        now = Clock::now();
+    }
+
+    recordJitter(now - deadline);
+}
+
+void FramePacer::adaptSpinMargin(Clock::duration lateness) {
+    // Follow the worst recent oversleep, decaying by 1/8 per frame, so we only spin as long as
+    // the timer needs: ~1 ms on Windows under timeBeginPeriod(1), far less elsewhere
+    oversleep = std::max(std::max(lateness, Clock::duration::zero()), oversleep - oversleep / 8);
+    Clock::duration margin = oversleep + std::chrono::microseconds(100);
+    spinMargin = std::clamp<Clock::duration>(margin, MIN_SPIN_MARGIN, MAX_SPIN_MARGIN);
+}
+
+void FramePacer::resync() {
+    frameStart = Clock::now();
+}
+
+void FramePacer::recordJitter(Clock::duration deviation) {
+    jitterSamples[jitterSampleIndex] = std::chrono::duration<float, std::milli>(deviation).count();
+    jitterSampleIndex = (jitterSampleIndex + 1) % JITTER_SAMPLE_COUNT;
+    if (jitterSampleCount < JITTER_SAMPLE_COUNT) {
+        jitterSampleCount++;
+    }
+}
+
+FramePacer::JitterStats FramePacer::getJitterStats() const {
+    JitterStats stats;
+    stats.samples = jitterSampleCount;
+    if (jitterSampleCount == 0) {
+        return stats;
+    }
+
+    std::array<float, JITTER_SAMPLE_COUNT> sorted;
+    double total = 0.0;
+    for (size_t i = 0; i < jitterSampleCount; i++) {
+        sorted[i] = std::abs(jitterSamples[i]);
+        total += sorted[i];
+    }
+    std::sort(sorted.begin(), sorted.begin() + jitterSampleCount);
+
+    size_t p99Index = std::min(jitterSampleCount - 1, (jitterSampleCount * 99) / 100);
+    stats.averageMs = total / static_cast<double>(jitterSampleCount);
+    stats.p99Ms = sorted[p99Index];
+    stats.maxMs = sorted[jitterSampleCount - 1];
+    return stats;
+}
+
+void FramePacer::setHighResolutionTimer(bool enabled) {
+    if (enabled == highResolutionTimer) {
+        return;
+    }
+#ifdef _WIN32
+    if (enabled) {
+        timeBeginPeriod(1);
+    } else {
+        timeEndPeriod(1);
+    }
+#endif
+    highResolutionTimer = enabled;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+class RenderScheduler;
+
+// Paces drawn frames to a target rate without relying on sf::sleep granularity.
+// Each frame sleeps until shortly before its deadline, then spins for the remainder; the spin
+// only covers the oversleep the system timer has recently shown.
+// The target rate follows what the cat is doing (punching, being interacted with, idle)
+// and the deviation of every paced frame from its deadline is recorded as jitter.
+class FramePacer {
+public:
+    enum class Profile {
+        Animating,   // 144 Hz - punch animation running
+        Interactive, // 60 Hz - dragging or settings window open
+        Idle         // 10 Hz - occasional redraws only
+    };
+
+    struct JitterStats {
+        double averageMs = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+        size_t samples = 0;
+    };
+
+    FramePacer();
+    ~FramePacer();
+
+    void setProfile(Profile profile);
+    Profile getProfile() const { return profile; }
+
+    // Start a frame; returns the seconds elapsed since the previous frame (clamped)
+    float beginFrame();
+
+    // Wait until the current frame's deadline. Returns early if the scheduler receives
+    // work (input, webview command) so it's never delayed by pacing.
+    void endFrame(RenderScheduler& scheduler);
+
+    // Forget the previous frame time, e.g. after the main loop slept while idle
+    void resync();
+
+    JitterStats getJitterStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t JITTER_SAMPLE_COUNT = 256;
+
+    Profile profile;
+    Clock::duration frameInterval;
+    Clock::time_point frameStart;
+    Clock::time_point lastFrameStart;
+    bool highResolutionTimer; // Windows: timeBeginPeriod(1) active
+    Clock::duration spinMargin; // Time before the deadline at which sleeping stops
+    Clock::duration oversleep;  // Worst recent wake-up past the sleep target, decaying
+
+    std::array<float, JITTER_SAMPLE_COUNT> jitterSamples; // Milliseconds late/early per frame
+    size_t jitterSampleCount;
+    size_t jitterSampleIndex;
+
+    void recordJitter(Clock::duration deviation);
+    void adaptSpinMargin(Clock::duration lateness);
+    void setHighResolutionTimer(bool enabled);
+};
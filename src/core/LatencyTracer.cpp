@@ -0,0 +1,158 @@
+#include "core/LatencyTracer.h"
+#include "utils/Logger.h"
+#include <algorithm>
+
+namespace {
+    // Windows removes a low-level hook that repeatedly exceeds LowLevelHooksTimeout (a few
+    // hundred ms); flag callbacks well before that so the cause shows up in the log first
+    constexpr auto DEFAULT_HOOK_BUDGET = std::chrono::milliseconds(10);
+
+    // The log keeps only its last lines, so repeated slow callbacks are reported sparsely
+    constexpr uint64_t SLOW_HOOK_LOG_EVERY = 100;
+
+    constexpr size_t MAX_AWAITING_PRESENT = 256;
+
+    size_t bucketFor(int64_t micros) {
+        size_t bucket = 0;
+        while (micros > 0 && bucket < 31) {
+            micros >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    // Upper edge of a bucket in milliseconds
+    double bucketLimitMs(size_t bucket) {
+        return static_cast<double>(uint64_t(1) << bucket) / 1000.0;
+    }
+}
+
+LatencyTracer::LatencyTracer()
+    : hookBudget(DEFAULT_HOOK_BUDGET), slowHookCount(0) {
+}
+
+void LatencyTracer::record(Stage stage, Clock::time_point inputTime) {
+    int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - inputTime).count();
+    micros = std::max<int64_t>(micros, 0);
+
+    Histogram& histogram = histograms[static_cast<size_t>(stage)];
+    histogram.buckets[bucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+    histogram.samples.fetch_add(1, std::memory_order_relaxed);
+
+    int64_t previousMax = histogram.maxMicros.load(std::memory_order_relaxed);
+    while (micros > previousMax && !histogram.maxMicros.compare_exchange_weak(previousMax, micros, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyTracer::recordPoseChanged(Clock::time_point inputTime) {
+    record(Stage::PoseChanged, inputTime);
+    // Bounded in case frames stop being presented (e.g. a draw keeps failing)
+    if (awaitingPresent.size() < MAX_AWAITING_PRESENT) {
+        awaitingPresent.push_back(inputTime);
+    }
+}
+
+std::optional<LatencyTracer::Clock::duration> LatencyTracer::recordPresented() {
+    if (awaitingPresent.empty()) {
+        return std::nullopt;
+    }
+    Clock::time_point now = Clock::now();
+    Clock::time_point oldest = awaitingPresent.front();
+    for (Clock::time_point inputTime : awaitingPresent) {
+        record(Stage::Presented, inputTime);
+        oldest = std::min(oldest, inputTime);
+    }
+    awaitingPresent.clear();
+    return now - oldest;
+}
+
+void LatencyTracer::recordHookCallback(Clock::time_point inputTime) {
+    record(Stage::HookCallback, inputTime);
+
+    Clock::duration elapsed = Clock::now() - inputTime;
+    if (elapsed > hookBudget.load()) {
+        uint64_t slowCount = slowHookCount.fetch_add(1) + 1;
+        if (slowCount == 1 || slowCount % SLOW_HOOK_LOG_EVERY == 0) {
+            LOG_WARNING("Hook callback took " +
+                        std::to_string(std::chrono::duration<double, std::milli>(elapsed).count()) +
+                        " ms (budget " + std::to_string(std::chrono::duration<double, std::milli>(hookBudget.load()).count()) +
+                        " ms, " + std::to_string(slowCount) + " slow callbacks so far) - the OS may remove slow hooks");
+        }
+    }
+}
+
+void LatencyTracer::reset() {
+    for (Histogram& histogram : histograms) {
+        for (auto& bucket : histogram.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        histogram.samples.store(0, std::memory_order_relaxed);
+        histogram.maxMicros.store(0, std::memory_order_relaxed);
+    }
+    slowHookCount = 0;
+}
+
+LatencyTracer::StageSummary LatencyTracer::getSummary(Stage stage) const {
+    const Histogram& histogram = histograms[static_cast<size_t>(stage)];
+
+    std::array<uint64_t, BUCKET_COUNT> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = histogram.buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+
+    StageSummary summary;
+    summary.samples = total;
+    if (total == 0) {
+        return summary;
+    }
+
+    // Percentiles resolve to the upper edge of the bucket they fall in
+    uint64_t p50Rank = (total + 1) / 2;
+    uint64_t p99Rank = std::max<uint64_t>(1, (total * 99 + 99) / 100);
+    uint64_t seen = 0;
+    bool p50Found = false;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts[i];
+        if (!p50Found && seen >= p50Rank) {
+            summary.p50Ms = bucketLimitMs(i);
+            p50Found = true;
+        }
+        if (seen >= p99Rank) {
+            summary.p99Ms = bucketLimitMs(i);
+            break;
+        }
+    }
+    summary.maxMs = static_cast<double>(histogram.maxMicros.load(std::memory_order_relaxed)) / 1000.0;
+    return summary;
+}
+
+const char* LatencyTracer::getStageName(Stage stage) {
+    switch (stage) {
+        case Stage::HookCallback: return "hook callback";
+        case Stage::Consumed: return "input consumed";
+        case Stage::PoseChanged: return "pose changed";
+        case Stage::Presented: return "frame presented";
+        case Stage::AudioStarted: return "audio started";
+        case Stage::Count: break;
+    }
+    return "unknown";
+}
+
+void LatencyTracer::logSummary() const {
+    for (size_t i = 0; i < STAGE_COUNT; i++) {
+        Stage stage = static_cast<Stage>(i);
+        StageSummary summary = getSummary(stage);
+        if (summary.samples == 0) {
+            continue;
+        }
+        LOG_INFO(std::string("Input latency (") + getStageName(stage) + ") - p50 <= " + std::to_string(summary.p50Ms) +
+                 " ms, p99 <= " + std::to_string(summary.p99Ms) + " ms, max: " + std::to_string(summary.maxMs) +
+                 " ms (" + std::to_string(summary.samples) + " inputs)");
+    }
+    uint64_t slowHooks = slowHookCount.load();
+    if (slowHooks > 0) {
+        LOG_WARNING("Slow hook callbacks: " + std::to_string(slowHooks));
+    }
+}
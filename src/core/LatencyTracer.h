@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Traces how long an input takes to reach the screen and the speakers.
+// Every hook event is stamped with steady_clock::now() in the callback; each stage it
+// reaches records the time since that stamp into a per-stage histogram.
+// Also acts as a watchdog for the hook callbacks themselves: low-level hooks that take
+// too long are silently removed by the OS, so slow callbacks are counted and logged.
+class LatencyTracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Stage {
+        HookCallback, // Time spent inside the hook callback
+        Consumed,     // Main loop took the punch off the input queue
+        PoseChanged,  // Simulation tick switched the cat to the punch pose
+        Presented,    // window.display() returned for the first frame showing the punch
+        AudioStarted, // Bonk sound started playing
+        Count
+    };
+
+    struct StageSummary {
+        uint64_t samples = 0;
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    static LatencyTracer& getInstance() {
+        static LatencyTracer instance;
+        return instance;
+    }
+
+    // Record that an input stamped at inputTime reached stage (thread-safe)
+    void record(Stage stage, Clock::time_point inputTime);
+
+    // Record a pose change and remember the input until the frame showing it is presented (main thread)
+    void recordPoseChanged(Clock::time_point inputTime);
+
+    // Call after window.display() returns. Records every input waiting for it and returns
+    // the latency of the oldest one, if any (main thread).
+    std::optional<Clock::duration> recordPresented();
+
+    // Call when a hook callback that started at inputTime returns; flags it if over budget
+    void recordHookCallback(Clock::time_point inputTime);
+
+    void setHookBudget(Clock::duration budget) { hookBudget = budget; }
+    uint64_t getSlowHookCount() const { return slowHookCount.load(); }
+
+    // Forget the histograms and slow hook count, e.g. before a measured run (thread-safe)
+    void reset();
+
+    StageSummary getSummary(Stage stage) const;
+    static const char* getStageName(Stage stage);
+
+    // Log a summary line per stage
+    void logSummary() const;
+
+private:
+    // Bucket i holds latencies in [2^(i-1), 2^i) microseconds; bucket 0 is under 1 us
+    static constexpr size_t BUCKET_COUNT = 32;
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(Stage::Count);
+
+    struct Histogram {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+        std::atomic<uint64_t> samples{0};
+        std::atomic<int64_t> maxMicros{0};
+    };
+
+    LatencyTracer();
+    LatencyTracer(const LatencyTracer&) = delete;
+    LatencyTracer& operator=(const LatencyTracer&) = delete;
+
+    std::array<Histogram, STAGE_COUNT> histograms;
+
+    std::vector<Clock::time_point> awaitingPresent; // Main thread only
+
+    std::atomic<Clock::duration> hookBudget;
+    std::atomic<uint64_t> slowHookCount;
+};
@@ -0,0 +1,66 @@
+#include "core/RenderScheduler.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+RenderScheduler::RenderScheduler()
+    : redrawPending(true), wakeEvent(nullptr) {
+    // Start with a pending redraw so the first frame is always drawn
+#ifdef _WIN32
+    // Auto-reset event: one SetEvent wakes exactly one wait
+    wakeEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+#endif
+}
+
+RenderScheduler::~RenderScheduler() {
+#ifdef _WIN32
+    if (wakeEvent) {
+        CloseHandle(static_cast<HANDLE>(wakeEvent));
+        wakeEvent = nullptr;
+    }
+#endif
+}
+
+void RenderScheduler::requestRedraw() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        redrawPending = true;
+    }
+    wakeCondition.notify_one();
+
+#ifdef _WIN32
+    if (wakeEvent) {
+        SetEvent(static_cast<HANDLE>(wakeEvent));
+    }
+#endif
+}
+
+bool RenderScheduler::consumeRedraw() {
+    return redrawPending.exchange(false);
+}
+
+bool RenderScheduler::waitForWork(std::chrono::milliseconds timeout) {
+    if (redrawPending) {
+        return true;
+    }
+    if (timeout.count() <= 0) {
+        return false;
+    }
+
+#ifdef _WIN32
+    // Low-level hooks are delivered to this thread as sent messages and the settings
+    // webview posts to it as well, so waking on any queued input covers both.
+    // The event handle covers requestRedraw() calls from other threads (Crow workers).
+    HANDLE handle = static_cast<HANDLE>(wakeEvent);
+    DWORD result = MsgWaitForMultipleObjectsEx(handle ? 1 : 0, handle ? &handle : nullptr,
+                                               static_cast<DWORD>(timeout.count()),
+                                               QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+    return result != WAIT_TIMEOUT;
+#else
+    // Sleep until the deadline; requestRedraw() (the hooks' reader thread, Crow workers) wakes it.
+    // Window events can't, so the caller bounds the timeout to see them (see main)
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    return wakeCondition.wait_for(lock, timeout, [this]() { return redrawPending.load(); });
+#endif
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Decides whether the main loop needs to render and lets it sleep when it doesn't.
+// Hook callbacks, the settings webview and timers call requestRedraw() from any thread;
+// the main loop blocks in waitForWork() while nothing is animating or pending.
+class RenderScheduler {
+public:
+    RenderScheduler();
+    ~RenderScheduler();
+
+    // Mark the window as needing a new frame and wake the main loop (thread-safe)
+    void requestRedraw();
+
+    // Returns true (and clears the flag) if a redraw was requested since the last call
+    bool consumeRedraw();
+
+    bool hasPendingRedraw() const { return redrawPending.load(); }
+
+    // Block until requestRedraw() is called, native input arrives or the timeout expires.
+    // Returns true if woken by work rather than the timeout. Only on Windows do window
+    // events end the wait (they are native input there).
+    bool waitForWork(std::chrono::milliseconds timeout);
+
+private:
+    std::atomic<bool> redrawPending;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    // Windows: event handle signalled by requestRedraw() so the message wait wakes up
+    void* wakeEvent;
+};
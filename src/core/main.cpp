@@ -7,6 +7,8 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <unordered_map>
+#include <functional>
 #include <memory>
 #include <filesystem>
 #include <fstream>
@@ -15,13 +17,18 @@
 #include <iomanip>
 #include <ctime>
 #include <thread>
+#include <atomic>
 #include <chrono>
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include "core/BongoCat.h"
 #include "input/KeyboardHook.h"
 #include "input/MouseHook.h"
+#include "input/InputTrace.h"
+#include "input/InputStress.h"
+#include "input/InputQueue.h"
 #include "utils/Logger.h"
 #include "config/CatPackConfig.h"
 #include "managers/CatPackManager.h"
@@ -31,10 +38,20 @@
 #include "audio/BonkPackManager.h"
 #include "utils/CounterEncryption.h"
 #include "core/BongoStats.h"
+#include "core/RenderScheduler.h"
+#include "core/FramePacer.h"
+#include "core/FrameBatch.h"
+#include "core/DirtyRegion.h"
+#include "core/LatencyTracer.h"
+#include "managers/CatPackLoader.h"
+#include "managers/TextureCache.h"
 #include "ui/WebViewWindow.h"
+#include "ui/SettingsWindowLifecycle.h"
+#include "ui/CounterDisplay.h"
+#include "ui/PerfOverlay.h"
 #include "utils/ImageHelper.h"
+#include "utils/JsonReader.h"
 #include <sstream>
-#include <regex>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -147,15 +164,16 @@ static std::vector<std::unique_ptr<SoundHolder>> g_activeSounds;
 static std::mutex g_soundsMutex;
 
 // Helper function to play sound file using SFML Audio (supports MP3)
-void PlaySoundFile(const std::string& soundPath, float volume = 100.0f) {
+// Returns true if the sound started playing
+bool PlaySoundFile(const std::string& soundPath, float volume = 100.0f) {
     if (soundPath.empty()) {
-        return; // No sound to play
+        return false; // No sound to play
     }
     
     // Check if file exists
     if (!std::filesystem::exists(soundPath)) {
         LOG_WARNING("Sound file not found: " + soundPath);
-        return;
+        return false;
     }
     
     try {
@@ -176,7 +194,7 @@ void PlaySoundFile(const std::string& soundPath, float volume = 100.0f) {
         // Load sound buffer from file
         if (!holder->buffer.loadFromFile(soundPath)) {
             LOG_WARNING("Failed to load sound file: " + soundPath);
-            return;
+            return false;
         }
         
         // Set volume and play (SFML volume is 0-100)
@@ -187,11 +205,22 @@ void PlaySoundFile(const std::string& soundPath, float volume = 100.0f) {
         g_activeSounds.push_back(std::move(holder));
         
         LOG_INFO("Playing sound: " + soundPath + " (volume: " + std::to_string(static_cast<int>(volume)) + "%)");
+        return true;
     } catch (const std::exception& e) {
         LOG_ERROR("Exception playing sound: " + std::string(e.what()) + " (file: " + soundPath + ")");
     } catch (...) {
         LOG_ERROR("Unknown exception playing sound: " + soundPath);
     }
+    return false;
+}
+
+// Number of sounds currently playing (for the performance overlay)
+size_t CountActiveSounds() {
+    std::lock_guard<std::mutex> lock(g_soundsMutex);
+    return static_cast<size_t>(std::count_if(g_activeSounds.begin(), g_activeSounds.end(),
+        [](const std::unique_ptr<SoundHolder>& holder) {
+            return holder->sound.getStatus() == sf::Sound::Status::Playing;
+        }));
 }
 #endif
 
@@ -268,7 +297,7 @@ int main() {
     // Create a small, always-on-top window (increased height for UI elements)
     sf::RenderWindow window(sf::VideoMode(sf::Vector2u(200, 260)), "Bongo Cat", 
                            sf::Style::None);
-    window.setFramerateLimit(60); // Optimize performance
+    // No setFramerateLimit() - frames are paced by FramePacer in the main loop
     LOG_INFO("Window created");
     
     // Get window handle early for message posting
@@ -307,6 +336,23 @@ int main() {
     // You can make it frameless later if needed
 #endif
     
+    // Cat images pre-scaled to the displayed size are kept between runs
+    TextureCache::getInstance().setDiskCacheDirectory((std::filesystem::path(appDataDir) / "OpenBongo.texcache").string());
+    
+    // Texture cache (see TextureCache):
+    //   OPENBONGO_TEXTURE_BUDGET_MB=<n>  decoded texture memory kept for packs and hats (default 96,
+    //                                    0 keeps only what is on screen)
+    if (const char* textureBudget = std::getenv("OPENBONGO_TEXTURE_BUDGET_MB")) {
+        char* budgetEnd = nullptr;
+        long budgetMB = std::strtol(textureBudget, &budgetEnd, 10);
+        if (budgetEnd != textureBudget && *budgetEnd == '\0' && budgetMB >= 0) {
+            TextureCache::getInstance().setBudget(static_cast<size_t>(budgetMB) * 1024 * 1024);
+            LOG_INFO("Texture cache budget: " + std::to_string(budgetMB) + " MB");
+        } else {
+            LOG_WARNING(std::string("Ignoring OPENBONGO_TEXTURE_BUDGET_MB=") + textureBudget + " (expected a whole number of MB)");
+        }
+    }
+    
     // Scan for available cat packs
     std::vector<CatPackConfig> availableCatPacks = CatPackManager::scanForCatPacks();
     if (availableCatPacks.empty()) {
@@ -377,23 +423,28 @@ int main() {
     
     // Find the selected bonk pack
     // Handle "No SFX" option specially (it's a UI-only option, not in scanned packs)
-    BonkPackConfig currentBonkPack;
+    BonkPackConfig startupBonkPack;
     if (selectedBonkPackName == "No SFX") {
-        currentBonkPack = BonkPackManager::getDefaultBonkPack();
-        currentBonkPack.name = "No SFX";
+        startupBonkPack = BonkPackManager::getDefaultBonkPack();
+        startupBonkPack.name = "No SFX";
         LOG_INFO("Loaded bonk pack: No SFX (disabled)");
     } else {
-        currentBonkPack = BonkPackManager::findBonkPackByName(availableBonkPacks, selectedBonkPackName);
-        if (currentBonkPack.name != selectedBonkPackName) {
+        startupBonkPack = BonkPackManager::findBonkPackByName(availableBonkPacks, selectedBonkPackName);
+        if (startupBonkPack.name != selectedBonkPackName) {
             // Selected pack not found, use "None"
-            currentBonkPack = BonkPackManager::getDefaultBonkPack();
-            selectedBonkPackName = currentBonkPack.name;
+            startupBonkPack = BonkPackManager::getDefaultBonkPack();
+            selectedBonkPackName = startupBonkPack.name;
         } else {
             // Log the loaded bonk pack info for debugging
-            LOG_INFO("Loaded bonk pack: " + currentBonkPack.name + ", bonkSound: " + currentBonkPack.bonkSound + ", folderPath: " + currentBonkPack.folderPath);
+            LOG_INFO("Loaded bonk pack: " + startupBonkPack.name + ", bonkSound: " + startupBonkPack.bonkSound + ", folderPath: " + startupBonkPack.folderPath);
         }
     }
     
+    
+    // The active pack is read by the hook callbacks (hook, replay and stress threads) while the settings
+    // server replaces it, so it's published as an immutable snapshot with std::atomic_load/atomic_store
+    std::shared_ptr<const BonkPackConfig> currentBonkPack = std::make_shared<const BonkPackConfig>(startupBonkPack);
+    
     // Create Bongo Cat with selected pack configuration
     // Use configurable cat size (default 100.0f)
     float catSize = 100.0f;
@@ -491,7 +542,8 @@ int main() {
     }
     
     // Load saved SFX volume or use default
-    float sfxVolume = 100.0f;
+    // Set by the settings server, read by the hook callbacks
+    std::atomic<float> sfxVolume{100.0f};
     std::string sfxVolumeConfigPath = (std::filesystem::path(appDataDir) / "OpenBongo.sfxvolume").string();
     
     // Load saved SFX volume
@@ -501,9 +553,7 @@ int main() {
         std::getline(sfxVolumeFile, volumeStr);
         if (!volumeStr.empty()) {
             try {
-                sfxVolume = std::stof(volumeStr);
-                if (sfxVolume < 0.0f) sfxVolume = 0.0f;
-                if (sfxVolume > 100.0f) sfxVolume = 100.0f;
+                sfxVolume = std::clamp(std::stof(volumeStr), 0.0f, 100.0f);
             } catch (...) {
                 sfxVolume = 100.0f;
             }
@@ -658,7 +708,7 @@ int main() {
     #endif
     
     // Counter for clicks and keypresses - load from persistent storage
-    int totalCount = 0;
+    std::atomic<int> totalCount{0}; // Atomic: the stress test reads it from its own thread
     
     // Load counter from file if it exists - save in stats folder
     std::string counterFilePath = (std::filesystem::path(statsDirPath) / "OpenBongo.counter").string();
@@ -680,42 +730,66 @@ int main() {
     };
     
     // Track key/mouse button states to prevent repeat triggers
-    // Use thread-safe approach with simple flags
     std::map<unsigned int, bool> keyStates; // Use virtual key code for tracking
     std::map<int, bool> mouseButtonStates; // Use ButtonType enum value
     
     // Track if taskbar was clicked (for repositioning window)
     bool taskbarWasClicked = false;
+    std::optional<int> pendingTaskbarSnapY; // Window top to snap to, applied by the main loop
+    
+    // Guards the four above: the hook callbacks also run on the replay and stress threads
+    // (injected events), alongside the real hooks' own thread
+    std::mutex hookStateMutex;
+    
+    // Wakes the main loop when something needs to be drawn (render-on-demand)
+    RenderScheduler renderScheduler;
+    
+    // Decodes cat packs selected in the settings UI off the render thread
+    CatPackLoader catPackLoader([&renderScheduler]() { renderScheduler.requestRedraw(); });
+    // Cat images scaled to their displayed size are made in the background too
+    TextureCache::getInstance().setScaledReadyCallback([&renderScheduler]() { renderScheduler.requestRedraw(); });
+    
+    // Presses from the hooks, applied by the main loop once per frame
+    InputQueue inputQueue;
     
     // Initialize keyboard hook with counter and state tracking
     KeyboardHook keyboardHook;
-    bool keyboardHookInitialized = keyboardHook.initialize([&bongoCat, &totalCount, &keyStates, &currentBonkPack, &sfxVolume](unsigned int keyCode, bool isPressed) {
+    bool keyboardHookInitialized = keyboardHook.initialize([&inputQueue, &keyStates, &hookStateMutex, &currentBonkPack, &sfxVolume, &renderScheduler](unsigned int keyCode, bool isPressed) {
+        // Every input is stamped here so its latency can be traced through the frame and the bonk
+        const auto inputTime = std::chrono::steady_clock::now();
         try {
             if (isPressed) {
                 // Only trigger if key wasn't already pressed (prevent repeat on hold)
-                if (!keyStates[keyCode]) {
+                bool firstPress = false;
+                {
+                    std::lock_guard<std::mutex> lock(hookStateMutex);
+                    firstPress = !keyStates[keyCode];
                     keyStates[keyCode] = true;
-                    totalCount++;
-                    BongoStats::getInstance().recordKeyPress(keyCode);
-                    bongoCat.punch();
+                }
+                if (firstPress) {
+                    inputQueue.push({inputTime, false, keyCode});
+                    renderScheduler.requestRedraw();
                     
                     // Play bonk effect SFX if not "None" or "No SFX"
-                    if (currentBonkPack.name != "None" && currentBonkPack.name != "No SFX") {
-                        if (currentBonkPack.bonkSound.empty()) {
-                            LOG_WARNING("Key pressed but bonkSound is empty for pack: " + currentBonkPack.name);
-                        } else if (currentBonkPack.folderPath.empty()) {
-                            LOG_WARNING("Key pressed but folderPath is empty for pack: " + currentBonkPack.name);
+                    std::shared_ptr<const BonkPackConfig> bonkPack = std::atomic_load(&currentBonkPack);
+                    if (bonkPack->name != "None" && bonkPack->name != "No SFX") {
+                        if (bonkPack->bonkSound.empty()) {
+                            LOG_WARNING("Key pressed but bonkSound is empty for pack: " + bonkPack->name);
+                        } else if (bonkPack->folderPath.empty()) {
+                            LOG_WARNING("Key pressed but folderPath is empty for pack: " + bonkPack->name);
                         } else {
-                            std::string bonkSoundPath = currentBonkPack.getSoundPath(currentBonkPack.bonkSound);
+                            std::string bonkSoundPath = bonkPack->getSoundPath(bonkPack->bonkSound);
                             if (bonkSoundPath.empty()) {
-                                LOG_WARNING("Key pressed but sound path is empty (pack: " + currentBonkPack.name + ", sound: " + currentBonkPack.bonkSound + ", folder: " + currentBonkPack.folderPath + ")");
+                                LOG_WARNING("Key pressed but sound path is empty (pack: " + bonkPack->name + ", sound: " + bonkPack->bonkSound + ", folder: " + bonkPack->folderPath + ")");
                             } else {
                                 // Verify file exists before attempting to play
                                 if (std::filesystem::exists(bonkSoundPath)) {
                                     LOG_INFO("Key pressed - Playing bonk sound: " + bonkSoundPath);
-                                    PlaySoundFile(bonkSoundPath, sfxVolume);
+                                    if (PlaySoundFile(bonkSoundPath, sfxVolume)) {
+                                        LatencyTracer::getInstance().record(LatencyTracer::Stage::AudioStarted, inputTime);
+                                    }
                                 } else {
-                                    LOG_WARNING("Key pressed but bonk sound file not found: " + bonkSoundPath + " (pack: " + currentBonkPack.name + ", folder: " + currentBonkPack.folderPath + ")");
+                                    LOG_WARNING("Key pressed but bonk sound file not found: " + bonkSoundPath + " (pack: " + bonkPack->name + ", folder: " + bonkPack->folderPath + ")");
                                 }
                             }
                         }
@@ -724,6 +798,7 @@ int main() {
                 }
             } else {
                 // Key released - reset state
+                std::lock_guard<std::mutex> lock(hookStateMutex);
                 keyStates[keyCode] = false;
             }
         } catch (const std::exception& e) {
@@ -731,21 +806,21 @@ int main() {
         } catch (...) {
             LOG_ERROR("Unknown exception in keyboard hook callback");
         }
+        LatencyTracer::getInstance().recordHookCallback(inputTime);
     });
     
     
     // Initialize mouse hook for global click detection
     MouseHook mouseHook;
-    bool mouseHookInitialized = mouseHook.initialize([&bongoCat, &totalCount, &mouseButtonStates, &taskbarWasClicked, &window](MouseHook::ButtonType button, bool isPressed) {
+    bool mouseHookInitialized = mouseHook.initialize([&inputQueue, &mouseButtonStates, &taskbarWasClicked, &pendingTaskbarSnapY, &hookStateMutex, &renderScheduler](MouseHook::ButtonType button, bool isPressed) {
+        const auto inputTime = std::chrono::steady_clock::now();
         try {
-            std::string buttonName = (button == MouseHook::BUTTON_LEFT) ? "LEFT" : 
-                                    (button == MouseHook::BUTTON_RIGHT) ? "RIGHT" : "MIDDLE";
-            
             if (isPressed) {
                 // Check if click is on taskbar
                 #ifdef _WIN32
                 POINT cursorPos;
                 if (GetCursorPos(&cursorPos)) {
+                    std::lock_guard<std::mutex> lock(hookStateMutex);
                     // Check if cursor is on the taskbar (outside work area but inside monitor bounds)
                     HMONITOR hMonitor = MonitorFromPoint(cursorPos, MONITOR_DEFAULTTONEAREST);
                     MONITORINFO mi = { sizeof(MONITORINFO) };
@@ -765,12 +840,10 @@ int main() {
                             // Was clicking taskbar/outside, now clicked inside work area - snap!
                             // Snap so the ANCHOR line aligns with work area bottom
                             // This effectively "lands" the cat on the taskbar
-                            int newX = window.getPosition().x;
-                            // Re-use logic: WindowTop = WorkAreaBottom - 200
-                            int newY = mi.rcWork.bottom - 200;
-                            
-                            window.setPosition(sf::Vector2i(newX, newY));
+                            // Re-use logic: WindowTop = WorkAreaBottom - 200 (the window is moved on the main thread)
+                            pendingTaskbarSnapY = mi.rcWork.bottom - 200;
                             taskbarWasClicked = false;
+                            renderScheduler.requestRedraw();
                         }
                     }
                 }
@@ -778,14 +851,19 @@ int main() {
                 #endif
                 
                 // Only trigger if button wasn't already pressed (prevent repeat on hold)
-                if (!mouseButtonStates[button]) {
+                bool firstPress = false;
+                {
+                    std::lock_guard<std::mutex> lock(hookStateMutex);
+                    firstPress = !mouseButtonStates[button];
                     mouseButtonStates[button] = true;
-                    totalCount++;
-                    BongoStats::getInstance().recordMouseClick(buttonName);
-                    bongoCat.punch();
+                }
+                if (firstPress) {
+                    inputQueue.push({inputTime, true, static_cast<unsigned int>(button)});
+                    renderScheduler.requestRedraw();
                 }
             } else {
                 // Button released - reset state
+                std::lock_guard<std::mutex> lock(hookStateMutex);
                 mouseButtonStates[button] = false;
             }
         } catch (const std::exception& e) {
@@ -793,6 +871,7 @@ int main() {
         } catch (...) {
             LOG_ERROR("Unknown exception in mouse hook callback");
         }
+        LatencyTracer::getInstance().recordHookCallback(inputTime);
     });
     
     if (!mouseHookInitialized) {
@@ -807,6 +886,72 @@ int main() {
         LOG_INFO("Keyboard hook initialized successfully");
     }
     
+    // Input traces, for reproducing a typing session without a keyboard (set in the environment):
+    //   OPENBONGO_RECORD_INPUT=<file>  record every hook event
+    //   OPENBONGO_REPLAY_INPUT=<file>  replay a recording through the hook callbacks,
+    //   OPENBONGO_REPLAY_SPEED=<n>     at n times the recorded speed (default 1, "max" for no waiting)
+    std::shared_ptr<InputTraceRecorder> inputRecorder;
+    if (const char* recordPath = std::getenv("OPENBONGO_RECORD_INPUT")) {
+        inputRecorder = std::make_shared<InputTraceRecorder>();
+        if (inputRecorder->open(recordPath)) {
+            keyboardHook.setRecorder(inputRecorder);
+            mouseHook.setRecorder(inputRecorder);
+        }
+    }
+    InputTraceReplayer inputReplayer;
+    if (const char* replayPath = std::getenv("OPENBONGO_REPLAY_INPUT")) {
+        if (inputReplayer.load(replayPath)) {
+            double replaySpeed = 1.0;
+            if (const char* speedText = std::getenv("OPENBONGO_REPLAY_SPEED")) {
+                char* speedEnd = nullptr;
+                double parsedSpeed = std::strtod(speedText, &speedEnd);
+                if (std::string(speedText) == "max") {
+                    replaySpeed = 0.0;
+                } else if (speedEnd != speedText && *speedEnd == '\0' && parsedSpeed > 0.0) {
+                    replaySpeed = parsedSpeed;
+                } else {
+                    LOG_WARNING(std::string("Ignoring OPENBONGO_REPLAY_SPEED=") + speedText + " (expected a number above 0 or \"max\"), replaying in real time");
+                }
+            }
+            // Same arm choices on every run
+            bongoCat.setRandomSeed(0);
+            auto replayStart = std::chrono::steady_clock::now();
+            inputReplayer.start(replaySpeed,
+                [&keyboardHook](unsigned int keyCode, bool isPressed) { keyboardHook.injectKey(keyCode, isPressed); },
+                [&mouseHook](int button, bool isPressed) { mouseHook.injectButton(static_cast<MouseHook::ButtonType>(button), isPressed); },
+                [replayStart, eventCount = inputReplayer.getEventCount()]() {
+                    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - replayStart).count();
+                    LOG_INFO("Input replay finished: " + std::to_string(eventCount) + " events in " + std::to_string(seconds) + " s");
+                });
+        }
+    }
+    
+    // Stress mode: synthetic key/mouse load injected through the hook callbacks, with a report in the log
+    //   OPENBONGO_STRESS_RATE=<events/s>  100-5000, enables the test
+    //   OPENBONGO_STRESS_PATTERN=<name>   typing (default), autoclicker or repeat
+    //   OPENBONGO_STRESS_SECONDS=<n>      length of the load (default 30)
+    InputStressTest stressTest(
+        [&keyboardHook](unsigned int keyCode, bool isPressed) { keyboardHook.injectKey(keyCode, isPressed); },
+        [&mouseHook](int button, bool isPressed) { mouseHook.injectButton(static_cast<MouseHook::ButtonType>(button), isPressed); });
+    if (const char* stressRate = std::getenv("OPENBONGO_STRESS_RATE")) {
+        InputStressTest::Config stressConfig;
+        stressConfig.eventsPerSecond = std::atof(stressRate);
+        if (const char* patternName = std::getenv("OPENBONGO_STRESS_PATTERN")) {
+            if (!InputStressTest::parsePattern(patternName, stressConfig.pattern)) {
+                LOG_WARNING("Unknown stress pattern '" + std::string(patternName) + "', using typing");
+            }
+        }
+        if (const char* stressSeconds = std::getenv("OPENBONGO_STRESS_SECONDS")) {
+            stressConfig.duration = std::chrono::seconds(std::max(1, std::atoi(stressSeconds)));
+        }
+        bongoCat.setRandomSeed(0);
+        stressTest.start(stressConfig, [&totalCount]() { return totalCount.load(); },
+                         [&stressTest, &renderScheduler]() {
+                             stressTest.logReport();
+                             renderScheduler.requestRedraw();
+                         });
+    }
+    
     // Load font for counter text
     sf::Font font;
     bool fontLoaded = false;
@@ -829,7 +974,7 @@ int main() {
     
     // Create text with font (SFML 3.0 requires font in constructor)
     // Only create if font loaded successfully
-    std::unique_ptr<sf::Text> counterTextPtr;
+    std::unique_ptr<CounterDisplay> counterDisplayPtr;
     std::unique_ptr<sf::RectangleShape> counterBoxPtr;
     std::unique_ptr<sf::RectangleShape> menuButtonPtr;
     std::unique_ptr<sf::RectangleShape> menuButtonLine1Ptr;
@@ -882,7 +1027,28 @@ int main() {
     
     // Settings window using WebViewWindow (Crow + HTML UI)
     std::unique_ptr<WebViewWindow> settingsWebView;
-    bool settingsWindowOpen = false;
+    std::atomic<bool> settingsWindowOpen{false}; // Also read by the settings UI thread once its window exists
+    
+    // Settings window lifecycle (see SettingsWindowLifecycle):
+    //   OPENBONGO_SETTINGS_PREWARM=0          don't create the window ahead of the first click
+    //   OPENBONGO_SETTINGS_PREWARM_DELAY=<s>  earliest prewarm after startup (default 5)
+    //   OPENBONGO_SETTINGS_RECLAIM=<s>        tear it down after this long hidden (default 300, 0 keeps it)
+    SettingsWindowLifecycle::Policy settingsPolicy;
+    if (const char* prewarm = std::getenv("OPENBONGO_SETTINGS_PREWARM")) {
+        settingsPolicy.prewarm = std::atoi(prewarm) != 0;
+    }
+    if (const char* prewarmDelay = std::getenv("OPENBONGO_SETTINGS_PREWARM_DELAY")) {
+        settingsPolicy.prewarmDelay = std::chrono::seconds(std::max(0, std::atoi(prewarmDelay)));
+    }
+    if (const char* reclaimAfter = std::getenv("OPENBONGO_SETTINGS_RECLAIM")) {
+        settingsPolicy.reclaimAfter = std::chrono::seconds(std::max(0, std::atoi(reclaimAfter)));
+    }
+    // A prewarmed window has to stay out of sight until it is asked for
+    settingsPolicy.prewarm = settingsPolicy.prewarm && WebViewWindow::canHideWindow();
+    SettingsWindowLifecycle settingsLifecycle(settingsPolicy, std::chrono::steady_clock::now());
+    bool settingsTracked = false;        // settingsLifecycle has been told the window exists
+    bool settingsTrackedVisible = false; // ... and that it is shown
+    std::atomic<bool> settingsWebViewFailed{false}; // Set from the settings UI thread when its window couldn't be created
     
     // Helper function to send JSON message to webview
     auto sendJSONToWebView = [](WebViewWindow& webView, const std::string& type, const std::string& jsonData) {
@@ -963,56 +1129,69 @@ int main() {
                 relativePath = "/" + relativePath;
             }
             
-            return "http://localhost:" + std::to_string(port) + relativePath;
+            return "http://127.0.0.1:" + std::to_string(port) + relativePath;
         } catch (...) {
             // Fallback: just use the filename
             try {
                 std::filesystem::path fullPath(fsPath);
                 std::string filename = fullPath.filename().string();
-                return "http://localhost:" + std::to_string(port) + "/" + filename;
+                return "http://127.0.0.1:" + std::to_string(port) + "/" + filename;
             } catch (...) {
                 return "";
             }
         }
     };
     
-    // Helper function to send cat pack list
-    auto sendCatPackList = [&sendJSONToWebView, &escapeJSON, &pathToUrl](WebViewWindow& webView, const std::vector<CatPackConfig>& packs) {
+    // Helper function to build the cat pack list JSON
+    auto catPackListJSON = [&escapeJSON, &pathToUrl](int port, const std::vector<CatPackConfig>& packs) -> std::string {
         std::stringstream ss;
         ss << "[";
         for (size_t i = 0; i < packs.size(); i++) {
             if (i > 0) ss << ",";
             std::string iconPath = packs[i].getImagePath(packs[i].iconImage);
-            std::string iconUrl = iconPath.empty() ? "" : pathToUrl(iconPath, 18080);
+            std::string iconUrl = iconPath.empty() ? "" : pathToUrl(iconPath, port);
             ss << "{\"name\":\"" << escapeJSON(packs[i].name) << "\",\"iconPath\":\"" << escapeJSON(iconUrl) << "\"}";
         }
         ss << "]";
-        LOG_INFO("Sending cat pack list: " + ss.str());
-        sendJSONToWebView(webView, "catPackList", ss.str());
+        return ss.str();
+    };
+    
+    // Helper function to send cat pack list
+    auto sendCatPackList = [&sendJSONToWebView, &catPackListJSON](WebViewWindow& webView, const std::vector<CatPackConfig>& packs) {
+        std::string jsonStr = catPackListJSON(webView.getServerPort(), packs);
+        LOG_INFO("Sending cat pack list: " + jsonStr);
+        sendJSONToWebView(webView, "catPackList", jsonStr);
+    };
+    
+    // Helper function to build the bonk pack list JSON
+    auto bonkPackListJSON = [&escapeJSON, &pathToUrl](int port, const std::vector<BonkPackConfig>& packs) -> std::string {
+        std::stringstream ss;
+        ss << "[";
+        bool first = true;
+        for (size_t i = 0; i < packs.size(); i++) {
+            try {
+                std::string iconPath = packs[i].getImagePath(packs[i].iconImage);
+                std::string iconUrl = iconPath.empty() ? "" : pathToUrl(iconPath, port);
+                if (!first) ss << ",";
+                ss << "{\"name\":\"" << escapeJSON(packs[i].name) << "\",\"iconPath\":\"" << escapeJSON(iconUrl) << "\"}";
+                first = false;
+            } catch (const std::exception& e) {
+                LOG_ERROR("Error processing bonk pack at index " + std::to_string(i) + ": " + e.what());
+                // Skip this pack and continue
+                continue;
+            } catch (...) {
+                LOG_ERROR("Unknown error processing bonk pack at index " + std::to_string(i));
+                continue;
+            }
+        }
+        ss << "]";
+        return ss.str();
     };
     
     // Helper function to send bonk pack list
-    auto sendBonkPackList = [&sendJSONToWebView, &escapeJSON, &pathToUrl](WebViewWindow& webView, const std::vector<BonkPackConfig>& packs) {
+    auto sendBonkPackList = [&sendJSONToWebView, &bonkPackListJSON](WebViewWindow& webView, const std::vector<BonkPackConfig>& packs) {
         try {
-            std::stringstream ss;
-            ss << "[";
-            for (size_t i = 0; i < packs.size(); i++) {
-                if (i > 0) ss << ",";
-                try {
-                    std::string iconPath = packs[i].getImagePath(packs[i].iconImage);
-                    std::string iconUrl = iconPath.empty() ? "" : pathToUrl(iconPath, 18080);
-                    ss << "{\"name\":\"" << escapeJSON(packs[i].name) << "\",\"iconPath\":\"" << escapeJSON(iconUrl) << "\"}";
-                } catch (const std::exception& e) {
-                    LOG_ERROR("Error processing bonk pack at index " + std::to_string(i) + ": " + e.what());
-                    // Skip this pack and continue
-                    continue;
-                } catch (...) {
-                    LOG_ERROR("Unknown error processing bonk pack at index " + std::to_string(i));
-                    continue;
-                }
-            }
-            ss << "]";
-            std::string jsonStr = ss.str();
+            std::string jsonStr = bonkPackListJSON(webView.getServerPort(), packs);
             LOG_INFO("Sending bonk pack list: " + jsonStr);
             sendJSONToWebView(webView, "bonkPackList", jsonStr);
         } catch (const std::exception& e) {
@@ -1028,18 +1207,23 @@ int main() {
         sendJSONToWebView(webView, "selectedBonkPack", json);
     };
     
-    auto sendHatList = [&sendJSONToWebView, &escapeJSON, &pathToUrl](WebViewWindow& webView, const std::vector<HatConfig>& hats) {
+    auto hatListJSON = [&escapeJSON, &pathToUrl](int port, const std::vector<HatConfig>& hats) -> std::string {
         std::stringstream ss;
         ss << "[";
         for (size_t i = 0; i < hats.size(); i++) {
             if (i > 0) ss << ",";
             std::string iconPath = hats[i].iconImage.empty() ? "" : hats[i].getImagePath(hats[i].iconImage);
-            std::string iconUrl = iconPath.empty() ? "" : pathToUrl(iconPath, 18080);
+            std::string iconUrl = iconPath.empty() ? "" : pathToUrl(iconPath, port);
             ss << "{\"name\":\"" << escapeJSON(hats[i].name) << "\",\"iconPath\":\"" << escapeJSON(iconUrl) << "\"}";
         }
         ss << "]";
-        LOG_INFO("Sending hat list: " + ss.str());
-        sendJSONToWebView(webView, "hatList", ss.str());
+        return ss.str();
+    };
+    
+    auto sendHatList = [&sendJSONToWebView, &hatListJSON](WebViewWindow& webView, const std::vector<HatConfig>& hats) {
+        std::string jsonStr = hatListJSON(webView.getServerPort(), hats);
+        LOG_INFO("Sending hat list: " + jsonStr);
+        sendJSONToWebView(webView, "hatList", jsonStr);
     };
     
     // Helper function to send selected cat pack
@@ -1056,99 +1240,582 @@ int main() {
         sendJSONToWebView(webView, "selectedHat", json);
     };
     
-    // Helper function to parse JSON message from webview
-    auto parseMessage = [](const std::string& message) -> std::map<std::string, std::string> {
-        std::map<std::string, std::string> result;
-        // Simple JSON parsing for our use case
-        std::regex typeRegex("\"type\"\\s*:\\s*\"([^\"]+)\"");
-        std::smatch typeMatch;
-        if (std::regex_search(message, typeMatch, typeRegex)) {
-            result["type"] = typeMatch[1].str();
-        }
-        
-        // Extract name from data if present
-        std::regex nameRegex("\"name\"\\s*:\\s*\"([^\"]+)\"");
-        std::smatch nameMatch;
-        if (std::regex_search(message, nameMatch, nameRegex)) {
-            result["name"] = nameMatch[1].str();
+    if (fontLoaded) {
+        counterDisplayPtr = std::make_unique<CounterDisplay>();
+        if (counterDisplayPtr->initialize(font, 13)) { // 18 * 0.7 ≈ 12.6, rounded to 13 for readability
+            counterDisplayPtr->setColor(sf::Color(80, 80, 80)); // Dark grey text
+            counterDisplayPtr->setBox(sf::FloatRect(sf::Vector2f(counterBoxX, uiY), sf::Vector2f(counterBoxWidth, counterBoxHeight)));
+            counterDisplayPtr->setValue(totalCount);
+        } else {
+            counterDisplayPtr.reset();
         }
-        
-        return result;
-    };
+    }
     
+    // Performance overlay, toggled with F3 while the cat window has focus
+    std::unique_ptr<PerfOverlay> perfOverlayPtr;
     if (fontLoaded) {
-        counterTextPtr = std::make_unique<sf::Text>(font, "0");
-        counterTextPtr->setCharacterSize(13); // 18 * 0.7 ≈ 12.6, rounded to 13 for readability
-        counterTextPtr->setFillColor(sf::Color(80, 80, 80)); // Dark grey text
-        // Center text in counter box (estimate width based on character count)
-        // Approximate: character width is about 60% of character size for monospace-like fonts
-        std::string initialText = std::to_string(totalCount);
-        float estimatedWidth = initialText.length() * counterTextPtr->getCharacterSize() * 0.6f;
-        float textX = counterBoxX + (counterBoxWidth - estimatedWidth) / 2.0f;
-        float textY = uiY + (counterBoxHeight - counterTextPtr->getCharacterSize()) / 2.0f;
-        counterTextPtr->setPosition(sf::Vector2f(textX, textY));
-        counterTextPtr->setString(initialText);
+        perfOverlayPtr = std::make_unique<PerfOverlay>(font);
     }
     
     // Main loop
-    sf::Clock clock;
+    FramePacer framePacer;
+    FrameBatch frameBatch; // Reused every frame so the vertex array keeps its capacity
+    DirtyRegion dirtyRegion; // What changed since the last presented frame; frames with nothing changed aren't drawn
+    bool windowDrawn = false;
+    int lastDrawnCount = totalCount;
     bool dragging = false;
     sf::Vector2i dragOffset;
+    std::vector<InputQueue::Press> drainedPresses; // Reused every frame, like frameBatch
+    std::vector<unsigned int> drainedKeyCodes;
+    std::optional<sf::Vector2i> pendingDragMouse; // Latest MouseMoved position while dragging, applied after polling
     
     LOG_INFO("Entering main loop");
-    // Flag to track if window needs to be recreated (for size changes)
-    bool shouldRecreateWindow = false;
-    bool shouldExit = false; // Flag to force exit from main loop
+    std::atomic<bool> shouldExit{false}; // Flag to force exit from main loop (also set by the settings server)
+    std::atomic<float> pendingCatSize{0.0f}; // Cat size chosen in settings, 0 when none pending
+    
+    // Other changes to the cat made in settings. Handlers run on the server's threads while the
+    // main loop draws and rebuilds the cat, so they queue these and the main loop applies them
+    struct CatCommand {
+        enum class Kind { SetHat, SetFlip, SetLeftArmOffset, SetRightArmOffset, SetAnimationVerticalOffset };
+        Kind kind;
+        HatConfig hat;        // SetHat
+        bool flipped = false; // SetFlip
+        float offset = 0.0f;  // Arm and animation offsets (slider values)
+    };
+    std::mutex catCommandMutex;
+    std::vector<CatCommand> pendingCatCommands;
+    std::vector<CatCommand> drainedCatCommands; // Reused every frame, like drainedPresses
+    auto postCatCommand = [&](CatCommand command) {
+        std::lock_guard<std::mutex> lock(catCommandMutex);
+        pendingCatCommands.push_back(std::move(command));
+    };
 
     int loopIteration = 0;
     
-    while ((window.isOpen() || shouldRecreateWindow) && !shouldExit) {
-        // Handle window recreation if requested
-        if (shouldRecreateWindow) {
-            // Get current position to restore it
-            sf::Vector2i currentPos = window.getPosition();
+    // Periodic saves are time-based because idle iterations are skipped
+    const auto counterSaveInterval = std::chrono::milliseconds(1500);
+    const auto statsSaveInterval = std::chrono::seconds(16);
+    auto nextCounterSaveTime = std::chrono::steady_clock::now() + counterSaveInterval;
+    auto nextStatsSaveTime = std::chrono::steady_clock::now() + statsSaveInterval;
+    int lastSavedCount = totalCount;
+    
+    // Settings UI commands by message type. Each handler reads the fields it needs straight from the message.
+    std::unordered_map<std::string, std::function<void(const JsonReader&)>> settingsMessageHandlers;
+    
+    // A setting slider value: applied and saved only if it parses and lies in [minValue, maxValue]
+    auto readRangedNumber = [](const JsonReader& message, const char* key, double minValue, double maxValue, double& value) {
+        return message.getNumber(key, value) && value >= minValue && value <= maxValue;
+    };
+    
+    // Size-specific arm settings: applied to the cat (which keeps them across size changes) and saved
+    // under the size they belong to
+    auto applyRightArmOffset = [&](float offset, int forSize) {
+        postCatCommand({CatCommand::Kind::SetRightArmOffset, {}, false, offset});
+        LOG_INFO("Right arm offset set to: " + std::to_string(offset));
+        
+        // Save right arm offset to file (size-specific)
+        std::string rightArmOffsetConfigPath = (std::filesystem::path(appDataDir) / ("OpenBongo.rightarmoffset_size_" + std::to_string(forSize))).string();
+        std::ofstream rightArmOffsetOutFile(rightArmOffsetConfigPath);
+        if (rightArmOffsetOutFile.is_open()) {
+            rightArmOffsetOutFile << offset;
+            rightArmOffsetOutFile.close();
+            LOG_INFO("Right arm offset saved for size " + std::to_string(forSize) + ": " + std::to_string(offset));
+        }
+    };
+    
+    auto applyAnimationVerticalOffset = [&](float offset, int forSize) {
+        postCatCommand({CatCommand::Kind::SetAnimationVerticalOffset, {}, false, offset});
+        LOG_INFO("Animation vertical offset set to: " + std::to_string(offset));
+        
+        // Save animation vertical offset to file (size-specific)
+        std::string animationVerticalOffsetConfigPath = (std::filesystem::path(appDataDir) / ("OpenBongo.animationverticaloffset_size_" + std::to_string(forSize))).string();
+        std::ofstream animationVerticalOffsetOutFile(animationVerticalOffsetConfigPath);
+        if (animationVerticalOffsetOutFile.is_open()) {
+            animationVerticalOffsetOutFile << offset;
+            animationVerticalOffsetOutFile.close();
+            LOG_INFO("Animation vertical offset saved for size " + std::to_string(forSize) + ": " + std::to_string(offset));
+        }
+    };
+    
+    settingsMessageHandlers["ready"] = [&](const JsonReader&) {
+        // Page loaded: send everything it shows in one message
+        LOG_INFO("Settings page ready, sending initial state");
+        int port = settingsWebView->getServerPort();
+        
+        std::string accentColorConfigPath = (std::filesystem::path(appDataDir) / "OpenBongo.accentcolor").string();
+        std::string accentColor = "#4a90e2"; // Default blue
+        std::ifstream accentColorFile(accentColorConfigPath);
+        if (accentColorFile.is_open()) {
+            std::string colorStr;
+            std::getline(accentColorFile, colorStr);
+            if (!colorStr.empty() && colorStr[0] == '#') {
+                accentColor = colorStr;
+            }
+            accentColorFile.close();
+        }
+        
+        auto entry = [](const std::string& entryType, const std::string& data) {
+            return "{\"type\":\"" + entryType + "\",\"data\":" + data + "}";
+        };
+        std::string state = "[" +
+            entry("catPackList", catPackListJSON(port, availableCatPacks)) + "," +
+            entry("hatList", hatListJSON(port, availableHats)) + "," +
+            entry("bonkPackList", bonkPackListJSON(port, availableBonkPacks)) + "," +
+            entry("selectedCatPack", "{\"name\":\"" + escapeJSON(currentCatPack.name) + "\"}") + "," +
+            entry("selectedHat", "{\"name\":\"" + escapeJSON(currentHat.name) + "\"}") + "," +
+            entry("selectedBonkPack", "{\"name\":\"" + escapeJSON(std::atomic_load(&currentBonkPack)->name) + "\"}") + "," +
+            entry("catSize", "{\"size\":" + std::to_string(static_cast<int>(catSize)) + "}") + "," +
+            entry("uiOffset", "{\"offset\":" + std::to_string(static_cast<int>(uiOffset)) + "}") + "," +
+            entry("uiHorizontalOffset", "{\"offset\":" + std::to_string(static_cast<int>(uiHorizontalOffset)) + "}") + "," +
+            entry("sfxVolume", "{\"volume\":" + std::to_string(static_cast<int>(sfxVolume)) + "}") + "," +
+            entry("catFlip", std::string("{\"flipped\":") + (catFlipped ? "true" : "false") + "}") + "," +
+            entry("accentColor", "{\"color\":\"" + escapeJSON(accentColor) + "\"}") +
+            "]";
+        sendJSONToWebView(*settingsWebView, "initialState", state);
+    };
+    
+    settingsMessageHandlers["getCatPacks"] = [&](const JsonReader&) {
+        LOG_INFO("Sending cat packs list");
+        sendCatPackList(*settingsWebView, availableCatPacks);
+    };
+    settingsMessageHandlers["getHats"] = [&](const JsonReader&) {
+        LOG_INFO("Sending hats list");
+        sendHatList(*settingsWebView, availableHats);
+    };
+    settingsMessageHandlers["getBonkPacks"] = [&](const JsonReader&) {
+        LOG_INFO("Sending bonk packs list");
+        sendBonkPackList(*settingsWebView, availableBonkPacks);
+    };
+    settingsMessageHandlers["getSelectedCatPack"] = [&](const JsonReader&) {
+        LOG_INFO("Sending selected cat pack");
+        sendSelectedCatPack(*settingsWebView, currentCatPack);
+    };
+    settingsMessageHandlers["getSelectedHat"] = [&](const JsonReader&) {
+        LOG_INFO("Sending selected hat");
+        sendSelectedHat(*settingsWebView, currentHat);
+    };
+    settingsMessageHandlers["getSelectedBonkPack"] = [&](const JsonReader&) {
+        LOG_INFO("Sending selected bonk pack");
+        sendSelectedBonkPack(*settingsWebView, *std::atomic_load(&currentBonkPack));
+    };
+    settingsMessageHandlers["getWrappedStats"] = [&](const JsonReader&) {
+        LOG_INFO("Sending wrapped stats");
+        // getWrappedStatsJSON() reads directly from the JSON file
+        // It doesn't use any in-memory state, ensuring consistent results
+        std::string wrappedStats = BongoStats::getInstance().getWrappedStatsJSON();
+        LOG_INFO("Wrapped stats JSON: " + wrappedStats);
+        sendJSONToWebView(*settingsWebView, "wrappedStats", wrappedStats);
+    };
+    
+    settingsMessageHandlers["selectCatPack"] = [&](const JsonReader& message) {
+        std::string packName;
+        if (!message.getString("name", packName)) {
+            return;
+        }
+        CatPackConfig newCatPack = CatPackManager::findCatPackByName(availableCatPacks, packName);
+        if (newCatPack.name == packName) {
+            selectedCatPackName = packName;
+            currentCatPack = newCatPack;
+            catPackLoader.request(newCatPack); // Swapped in by the main loop once decoded
+            
+            // Save selection
+            std::ofstream catPackOutFile(catPackConfigPath);
+            if (catPackOutFile.is_open()) {
+                catPackOutFile << selectedCatPackName;
+                catPackOutFile.close();
+                LOG_INFO("Cat pack selection saved: " + selectedCatPackName);
+            }
+            
+            sendSelectedCatPack(*settingsWebView, currentCatPack);
+        }
+    };
+    
+    settingsMessageHandlers["selectHat"] = [&](const JsonReader& message) {
+        std::string hatName;
+        if (!message.getString("name", hatName)) {
+            return;
+        }
+        HatConfig newHat = HatManager::findHatByName(availableHats, hatName);
+        if (newHat.name == hatName) {
+            selectedHatName = hatName;
+            currentHat = newHat;
+            postCatCommand({CatCommand::Kind::SetHat, newHat});
+            
+            // Save selection
+            std::ofstream hatOutFile(hatConfigPath);
+            if (hatOutFile.is_open()) {
+                hatOutFile << selectedHatName;
+                hatOutFile.close();
+                LOG_INFO("Hat selection saved: " + selectedHatName);
+            }
+            
+            sendSelectedHat(*settingsWebView, currentHat);
+        }
+    };
+    
+    settingsMessageHandlers["selectBonkPack"] = [&](const JsonReader& message) {
+        std::string packName;
+        if (!message.getString("name", packName)) {
+            return;
+        }
+        BonkPackConfig newBonkPack;
+        // Handle "No SFX" option
+        if (packName == "No SFX") {
+            selectedBonkPackName = "No SFX";
+            newBonkPack = BonkPackManager::getDefaultBonkPack();
+            newBonkPack.name = "No SFX";
             
-            // Recreate window
-            window.create(sf::VideoMode(sf::Vector2u(200, 260)), "Bongo Cat", sf::Style::None);
-            window.setFramerateLimit(60);
+            LOG_INFO("Bonk pack selected: No SFX (disabled)");
+        } else {
+            newBonkPack = BonkPackManager::findBonkPackByName(availableBonkPacks, packName);
+            if (newBonkPack.name != packName) {
+                LOG_WARNING("Bonk pack not found: " + packName);
+                return;
+            }
+            selectedBonkPackName = packName;
             
-            // Restore position
-            window.setPosition(currentPos);
+            LOG_INFO("Bonk pack selected: " + packName + ", bonkSound: " + newBonkPack.bonkSound + ", folderPath: " + newBonkPack.folderPath);
+            
+            // Verify the sound file exists
+            if (newBonkPack.bonkSound.empty()) {
+                LOG_WARNING("Bonk sound filename is empty for pack: " + packName);
+            } else if (newBonkPack.folderPath.empty()) {
+                LOG_WARNING("Folder path is empty for pack: " + packName);
+            } else {
+                std::string testSoundPath = newBonkPack.getSoundPath(newBonkPack.bonkSound);
+                LOG_INFO("Constructed sound path: " + testSoundPath);
+                if (std::filesystem::exists(testSoundPath)) {
+                    LOG_INFO("Bonk sound file verified and exists: " + testSoundPath);
+                } else {
+                    LOG_WARNING("Bonk sound file NOT FOUND: " + testSoundPath);
+                    // Try to list directory contents for debugging
+                    try {
+                        if (std::filesystem::exists(newBonkPack.folderPath)) {
+                            LOG_INFO("Folder exists, listing contents:");
+                            for (const auto& entry : std::filesystem::directory_iterator(newBonkPack.folderPath)) {
+                                LOG_INFO("  - " + entry.path().filename().string());
+                            }
+                        } else {
+                            LOG_WARNING("Folder does not exist: " + newBonkPack.folderPath);
+                        }
+                    } catch (const std::exception& e) {
+                        LOG_ERROR("Error listing folder contents: " + std::string(e.what()));
+                    }
+                }
+            }
+        }
+        std::atomic_store(&currentBonkPack, std::make_shared<const BonkPackConfig>(newBonkPack));
+        
+        // Save selection to AppData
+        std::ofstream bonkPackOutFile(bonkPackConfigPath);
+        if (bonkPackOutFile.is_open()) {
+            bonkPackOutFile << selectedBonkPackName;
+            bonkPackOutFile.close();
+            LOG_INFO("Bonk pack selection saved to: " + bonkPackConfigPath);
+        } else {
+            LOG_ERROR("Failed to save bonk pack selection to: " + bonkPackConfigPath);
+        }
+        
+        sendSelectedBonkPack(*settingsWebView, newBonkPack);
+    };
+    
+    settingsMessageHandlers["setAccentColor"] = [&](const JsonReader& message) {
+        std::string color;
+        if (!message.getString("color", color) || color.empty()) {
+            return;
+        }
+        LOG_INFO("Accent color changed to: " + color);
+        
+        // Save accent color to file
+        std::string accentColorConfigPath = (std::filesystem::path(appDataDir) / "OpenBongo.accentcolor").string();
+        
+        std::ofstream accentColorOutFile(accentColorConfigPath);
+        if (accentColorOutFile.is_open()) {
+            accentColorOutFile << color;
+            accentColorOutFile.close();
+            LOG_INFO("Accent color saved: " + color);
+        }
+    };
+    
+    settingsMessageHandlers["setCatSize"] = [&](const JsonReader& message) {
+        double value = 0.0;
+        if (!readRangedNumber(message, "size", 50.0, 200.0, value)) {
+            return;
+        }
+        // Save the new size
+        catSize = static_cast<float>(static_cast<int>(value));
+        saveCatSize(catSize);
+        LOG_INFO("Saved cat size to: " + std::to_string(catSize));
+        
+        // The new size's arm settings come in the same message: separate messages may be handled
+        // in any order by the server, and must be saved under the size they belong to
+        double offset = 0.0;
+        if (readRangedNumber(message, "rightArmOffset", -50.0, 50.0, offset)) {
+            applyRightArmOffset(static_cast<float>(offset), static_cast<int>(catSize));
+        }
+        if (readRangedNumber(message, "animationVerticalOffset", -100.0, 100.0, offset)) {
+            applyAnimationVerticalOffset(static_cast<float>(offset), static_cast<int>(catSize));
+        }
+        
+        // Applied by the main loop at the next frame (no restart needed)
+        pendingCatSize = catSize;
+    };
+    
+    settingsMessageHandlers["setUIOffset"] = [&](const JsonReader& message) {
+        double value = 0.0;
+        if (!readRangedNumber(message, "offset", -50.0, 50.0, value)) {
+            return;
+        }
+        uiOffset = static_cast<float>(static_cast<int>(value));
+        
+        // Save UI offset to file
+        std::ofstream uiOffsetOutFile(uiOffsetConfigPath);
+        if (uiOffsetOutFile.is_open()) {
+            uiOffsetOutFile << uiOffset;
+            uiOffsetOutFile.close();
+            LOG_INFO("UI offset saved: " + std::to_string(uiOffset));
+        }
+    };
+    
+    settingsMessageHandlers["setUIHorizontalOffset"] = [&](const JsonReader& message) {
+        double value = 0.0;
+        if (!readRangedNumber(message, "offset", -50.0, 50.0, value)) {
+            return;
+        }
+        uiHorizontalOffset = static_cast<float>(static_cast<int>(value));
+        
+        // Save UI horizontal offset to file
+        std::ofstream uiHorizontalOffsetOutFile(uiHorizontalOffsetConfigPath);
+        if (uiHorizontalOffsetOutFile.is_open()) {
+            uiHorizontalOffsetOutFile << uiHorizontalOffset;
+            uiHorizontalOffsetOutFile.close();
+            LOG_INFO("UI horizontal offset saved: " + std::to_string(uiHorizontalOffset));
+        }
+    };
+    
+    settingsMessageHandlers["setSFXVolume"] = [&](const JsonReader& message) {
+        double value = 0.0;
+        if (!readRangedNumber(message, "volume", 0.0, 100.0, value)) {
+            return;
+        }
+        sfxVolume = static_cast<float>(static_cast<int>(value));
+        
+        // Save SFX volume to file
+        std::ofstream sfxVolumeOutFile(sfxVolumeConfigPath);
+        if (sfxVolumeOutFile.is_open()) {
+            sfxVolumeOutFile << sfxVolume.load();
+            sfxVolumeOutFile.close();
+            LOG_INFO("SFX volume saved: " + std::to_string(sfxVolume.load()));
+        }
+    };
+    
+    settingsMessageHandlers["setCatFlip"] = [&](const JsonReader& message) {
+        bool newFlipped = false;
+        if (!message.getBool("flipped", newFlipped)) {
+            return;
+        }
+        catFlipped = newFlipped;
+        postCatCommand({CatCommand::Kind::SetFlip, {}, catFlipped});
+        LOG_INFO("Cat flip changed to: " + std::string(catFlipped ? "true" : "false"));
+        
+        // Save cat flip to file
+        std::ofstream catFlipOutFile(catFlipConfigPath);
+        if (catFlipOutFile.is_open()) {
+            catFlipOutFile << (catFlipped ? "1" : "0");
+            catFlipOutFile.close();
+            LOG_INFO("Cat flip saved: " + std::string(catFlipped ? "true" : "false"));
+        }
+    };
+    
+    settingsMessageHandlers["setLeftArmOffset"] = [&](const JsonReader& message) {
+        double value = 0.0;
+        if (!readRangedNumber(message, "offset", -50.0, 50.0, value)) {
+            return;
+        }
+        float offset = static_cast<float>(value);
+        postCatCommand({CatCommand::Kind::SetLeftArmOffset, {}, false, offset});
+        LOG_INFO("Left arm offset set to: " + std::to_string(offset));
+        
+        // Save left arm offset to file
+        std::string leftArmOffsetConfigPath = (std::filesystem::path(appDataDir) / "OpenBongo.leftarmoffset").string();
+        std::ofstream leftArmOffsetOutFile(leftArmOffsetConfigPath);
+        if (leftArmOffsetOutFile.is_open()) {
+            leftArmOffsetOutFile << offset;
+            leftArmOffsetOutFile.close();
+            LOG_INFO("Left arm offset saved: " + std::to_string(offset));
+        }
+    };
+    
+    settingsMessageHandlers["setRightArmOffset"] = [&](const JsonReader& message) {
+        double value = 0.0;
+        if (readRangedNumber(message, "offset", -50.0, 50.0, value)) {
+            applyRightArmOffset(static_cast<float>(value), static_cast<int>(catSize));
+        }
+    };
+    
+    settingsMessageHandlers["setAnimationVerticalOffset"] = [&](const JsonReader& message) {
+        double value = 0.0;
+        if (readRangedNumber(message, "offset", -100.0, 100.0, value)) {
+            applyAnimationVerticalOffset(static_cast<float>(value), static_cast<int>(catSize));
+        }
+    };
+    
+    settingsMessageHandlers["shutdown"] = [&](const JsonReader&) {
+        // Shutdown the entire program
+        LOG_INFO("Shutdown requested from UI");
+        // Runs on a server thread: the main loop wakes, leaves and closes the window itself
+        shouldExit = true;
+        renderScheduler.requestRedraw();
+    };
+    
+    settingsMessageHandlers["hideWindow"] = [&](const JsonReader&) {
+        // Hide the window instead of closing it
+        if (settingsWebView && settingsWebView->isWindowValid()) {
+            settingsWebView->hideWindow();
+            settingsWindowOpen = false;
+            LOG_INFO("Settings window hidden");
+        }
+    };
+    
+    settingsMessageHandlers["openURL"] = [&](const JsonReader& message) {
+        std::string url;
+        if (!message.getString("url", url) || url.empty()) {
+            return;
+        }
+        LOG_INFO("Opening URL in default browser: " + url);
+        
+        #ifdef _WIN32
+        ShellExecuteA(nullptr, "open", url.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
+        #elif __APPLE__
+        std::string command = "open \"" + url + "\"";
+        system(command.c_str());
+        #else
+        // Linux
+        std::string command = "xdg-open \"" + url + "\"";
+        system(command.c_str());
+        #endif
+    };
+    
+    // Create the settings window (hidden when prewarming); it comes up on its own UI thread
+    auto createSettingsWebView = [&](bool prewarming) {
+        std::string htmlPath = "ui/index.html";
+        #ifdef _WIN32
+        if (!exeDirPath.empty()) {
+            try {
+                htmlPath = (std::filesystem::path(exeDirPath) / "ui" / "index.html").string();
+                if (!std::filesystem::exists(htmlPath)) {
+                    htmlPath = "ui/index.html";
+                }
+            } catch (...) {
+                htmlPath = "ui/index.html";
+            }
+        }
+        #endif
+        
+        settingsWebView = std::make_unique<WebViewWindow>();
+        
+        // Set up message handler
+        settingsWebView->setMessageHandler([&](const std::string& message) {
+        try {
+            // Check if webview is still valid before processing
+            if (!settingsWebView || !settingsWebView->isWindowValid()) {
+                LOG_WARNING("WebView is invalid, ignoring message");
+                return;
+            }
+            
+            LOG_INFO("Received message from webview: " + message);
+            JsonReader reader(message);
+            std::string type;
+            reader.getString("type", type);
+            
+            auto handler = settingsMessageHandlers.find(type);
+            if (handler == settingsMessageHandlers.end()) {
+                LOG_WARNING("Unknown webview message type: " + type);
+                return;
+            }
+            handler->second(reader);
+            
+            // Most commands change what the cat window shows - wake the main loop
+            renderScheduler.requestRedraw();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Exception handling webview message: " + std::string(e.what()));
+        }
+        });
+        
+        // Build the window on its own UI thread; the page asks for its data with "ready" once loaded
+        LOG_INFO(prewarming ? "Prewarming settings window" : "Creating settings window");
+        // A prewarmed window is created hidden and never shown (or focused) until it is opened
+        settingsWebView->openAsync(htmlPath, prewarming, [&settingsWebViewFailed, &settingsWindowOpen, &renderScheduler, prewarming, webView = settingsWebView.get()](bool created) {
+            if (!created) {
+                LOG_ERROR("Failed to initialize settings WebView window");
+                settingsWebViewFailed = true;
+                renderScheduler.requestRedraw();
+                return;
+            }
             
-            // Re-apply window styles
             #ifdef _WIN32
-            hwnd = window.getNativeHandle();
-            if (hwnd) {
-                // Set extended style to include topmost and layered window
-                LONG_PTR exStyle = GetWindowLongPtr(hwnd, GWL_EXSTYLE);
-                exStyle |= WS_EX_LAYERED | WS_EX_TOPMOST;
-                SetWindowLongPtr(hwnd, GWL_EXSTYLE, exStyle);
-                
-                // Set window to be always on top
-                SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+            HWND settingsHwnd = static_cast<HWND>(webView->getHwnd());
+            if (settingsHwnd) {
+                // Remove standard close button
+                LONG_PTR style = GetWindowLongPtr(settingsHwnd, GWL_STYLE);
+                style &= ~WS_SYSMENU; // Remove system menu (which includes close button)
+                SetWindowLongPtr(settingsHwnd, GWL_STYLE, style);
                 
-                // Set transprency color key
-                SetLayeredWindowAttributes(hwnd, RGB(255, 0, 255), 0, LWA_COLORKEY);
-                
-                // Add system menu
-                LONG_PTR style = GetWindowLongPtr(hwnd, GWL_STYLE);
-                style |= WS_SYSMENU;
-                SetWindowLongPtr(hwnd, GWL_STYLE, style);
+                SetWindowPos(settingsHwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
             }
             #endif
             
-            shouldRecreateWindow = false;
-            LOG_INFO("Window recreated successfully");
-        }
+            // Prewarmed (or closed again while it was starting): keep it loaded but out of sight
+            if (!settingsWindowOpen) {
+                webView->hideWindow();
+            } else if (prewarming) {
+                // Opened while it was still prewarming; showWindow() was a no-op until now
+                webView->showWindow();
+            }
+        });
+    };
+    
+    while (window.isOpen() && !shouldExit) {
         loopIteration++;
         
-        float deltaTime = clock.restart().asSeconds();
+        // Render on demand: with no punch animation or pending redraw there is nothing to draw,
+        // so block until a hook event, window event (drag), webview command or the next save is due
+        if (!renderScheduler.hasPendingRedraw() && !bongoCat.isAnimating()) {
+            auto nextDeadline = (totalCount != lastSavedCount) ? std::min(nextCounterSaveTime, nextStatsSaveTime) : nextStatsSaveTime;
+            // Wake for a settings window prewarm or reclaim
+            nextDeadline = std::min(nextDeadline, settingsLifecycle.getNextDeadline());
+            if (perfOverlayPtr && perfOverlayPtr->isVisible()) {
+                // Keep the overlay's numbers ticking while idle
+                nextDeadline = std::min(nextDeadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(250));
+            }
+            #ifndef _WIN32
+            // Window events don't end the wait here: don't sleep through a drag, and look at the
+            // window (close, expose) a few times a second otherwise
+            nextDeadline = std::min(nextDeadline, std::chrono::steady_clock::now() +
+                                                  (dragging ? std::chrono::milliseconds(0) : std::chrono::milliseconds(250)));
+            #endif
+            auto untilDeadline = std::chrono::duration_cast<std::chrono::milliseconds>(nextDeadline - std::chrono::steady_clock::now());
+            renderScheduler.waitForWork(std::max(untilDeadline, std::chrono::milliseconds(0)));
+            
+            // Time spent asleep must not count as animation time for the next punch
+            framePacer.resync();
+        }
+        
+        // Shutdown asked for from the settings UI (the window is closed after the loop)
+        if (shouldExit) {
+            break;
+        }
+        
+        float deltaTime = framePacer.beginFrame();
+        auto frameStartTime = std::chrono::steady_clock::now();
+        bool hadWindowEvent = false;
         
         // SFML 3.0 event handling - pollEvent returns optional
         try {
             while (const std::optional<sf::Event> eventOpt = window.pollEvent()) {
                 // Get the event value from optional
                 const sf::Event& event = *eventOpt;
+                hadWindowEvent = true;
                 
                 // SFML 3.0 event handling - check event type using if-else chain
                 // Try to access event data based on what type it might be
@@ -1175,6 +1842,9 @@ int main() {
                         LOG_INFO("Escape key pressed - closing window");
                     shouldExit = true;
                     window.close();
+                } else if (keyPressed->code == sf::Keyboard::Key::F3 && perfOverlayPtr) {
+                    // Toggle the performance overlay
+                    perfOverlayPtr->toggle();
                 }
             }
                 else if (const auto* mousePressed = event.getIf<sf::Event::MouseButtonPressed>()) {
@@ -1190,480 +1860,7 @@ int main() {
                             if (!settingsWindowOpen || !settingsWebView || !settingsWebView->isWindowValid()) {
                                 // Create WebViewWindow for settings if it doesn't exist
                                 if (!settingsWebView) {
-                                    std::string htmlPath = "ui/index.html";
-                                    #ifdef _WIN32
-                                    if (!exeDirPath.empty()) {
-                                        try {
-                                            htmlPath = (std::filesystem::path(exeDirPath) / "ui" / "index.html").string();
-                                            if (!std::filesystem::exists(htmlPath)) {
-                                                htmlPath = "ui/index.html";
-                                            }
-                                        } catch (...) {
-                                            htmlPath = "ui/index.html";
-                                        }
-                                    }
-                                    #endif
-                                    
-                                    settingsWebView = std::make_unique<WebViewWindow>();
-                                    
-                                    // Set up message handler
-                                    settingsWebView->setMessageHandler([&](const std::string& message) {
-                                    try {
-                                        // Check if webview is still valid before processing
-                                        if (!settingsWebView || !settingsWebView->isWindowValid()) {
-                                            LOG_WARNING("WebView is invalid, ignoring message");
-                                            return;
-                                        }
-                                        
-                                        LOG_INFO("Received message from webview: " + message);
-                                        auto parsed = parseMessage(message);
-                                        std::string type = parsed["type"];
-                                        LOG_INFO("Parsed message type: " + type);
-                                        
-                                        if (type == "getCatPacks") {
-                                            LOG_INFO("Sending cat packs list");
-                                            sendCatPackList(*settingsWebView, availableCatPacks);
-                                        } else if (type == "getHats") {
-                                            LOG_INFO("Sending hats list");
-                                            sendHatList(*settingsWebView, availableHats);
-                                        } else if (type == "getBonkPacks") {
-                                            LOG_INFO("Sending bonk packs list");
-                                            sendBonkPackList(*settingsWebView, availableBonkPacks);
-                                        } else if (type == "getSelectedCatPack") {
-                                            LOG_INFO("Sending selected cat pack");
-                                            sendSelectedCatPack(*settingsWebView, currentCatPack);
-                                        } else if (type == "getSelectedHat") {
-                                            LOG_INFO("Sending selected hat");
-                                            sendSelectedHat(*settingsWebView, currentHat);
-                                        } else if (type == "getSelectedBonkPack") {
-                                            LOG_INFO("Sending selected bonk pack");
-                                            sendSelectedBonkPack(*settingsWebView, currentBonkPack);
-                                        } else if (type == "getWrappedStats") {
-                                            LOG_INFO("Sending wrapped stats");
-                                            // getWrappedStatsJSON() reads directly from the JSON file
-                                            // It doesn't use any in-memory state, ensuring consistent results
-                                            std::string wrappedStats = BongoStats::getInstance().getWrappedStatsJSON();
-                                            LOG_INFO("Wrapped stats JSON: " + wrappedStats);
-                                            sendJSONToWebView(*settingsWebView, "wrappedStats", wrappedStats);
-                                        } else if (type == "selectCatPack") {
-                                            std::string packName = parsed["name"];
-                                            CatPackConfig newCatPack = CatPackManager::findCatPackByName(availableCatPacks, packName);
-                                            if (newCatPack.name == packName) {
-                                                selectedCatPackName = packName;
-                                                currentCatPack = newCatPack;
-                                                bongoCat.setConfig(newCatPack);
-                                                
-                                                // Save selection
-                                                std::ofstream catPackOutFile(catPackConfigPath);
-                                                if (catPackOutFile.is_open()) {
-                                                    catPackOutFile << selectedCatPackName;
-                                                    catPackOutFile.close();
-                                                    LOG_INFO("Cat pack selection saved: " + selectedCatPackName);
-                                                }
-                                                
-                                                sendSelectedCatPack(*settingsWebView, currentCatPack);
-                                            }
-                                        } else if (type == "selectHat") {
-                                            std::string hatName = parsed["name"];
-                                            HatConfig newHat = HatManager::findHatByName(availableHats, hatName);
-                                            if (newHat.name == hatName) {
-                                                selectedHatName = hatName;
-                                                currentHat = newHat;
-                                                bongoCat.setHat(newHat);
-                                                
-                                                // Save selection
-                                                std::ofstream hatOutFile(hatConfigPath);
-                                                if (hatOutFile.is_open()) {
-                                                    hatOutFile << selectedHatName;
-                                                    hatOutFile.close();
-                                                    LOG_INFO("Hat selection saved: " + selectedHatName);
-                                                }
-                                                
-                                                sendSelectedHat(*settingsWebView, currentHat);
-                                            }
-                                        } else if (type == "selectBonkPack") {
-                                            std::string packName = parsed["name"];
-                                            // Handle "No SFX" option
-                                            if (packName == "No SFX") {
-                                                selectedBonkPackName = "No SFX";
-                                                currentBonkPack = BonkPackManager::getDefaultBonkPack();
-                                                currentBonkPack.name = "No SFX";
-                                                
-                                                LOG_INFO("Bonk pack selected: No SFX (disabled)");
-                                                
-                                                // Save selection to AppData
-                                                std::ofstream bonkPackOutFile(bonkPackConfigPath);
-                                                if (bonkPackOutFile.is_open()) {
-                                                    bonkPackOutFile << selectedBonkPackName;
-                                                    bonkPackOutFile.close();
-                                                    LOG_INFO("Bonk pack selection saved to: " + bonkPackConfigPath);
-                                                } else {
-                                                    LOG_ERROR("Failed to save bonk pack selection to: " + bonkPackConfigPath);
-                                                }
-                                                
-                                                sendSelectedBonkPack(*settingsWebView, currentBonkPack);
-                                            } else {
-                                                BonkPackConfig newBonkPack = BonkPackManager::findBonkPackByName(availableBonkPacks, packName);
-                                                if (newBonkPack.name == packName) {
-                                                    selectedBonkPackName = packName;
-                                                    currentBonkPack = newBonkPack;
-                                                    
-                                                    LOG_INFO("Bonk pack selected: " + packName + ", bonkSound: " + currentBonkPack.bonkSound + ", folderPath: " + currentBonkPack.folderPath);
-                                                    
-                                                    // Verify the sound file exists
-                                                    if (currentBonkPack.bonkSound.empty()) {
-                                                        LOG_WARNING("Bonk sound filename is empty for pack: " + packName);
-                                                    } else if (currentBonkPack.folderPath.empty()) {
-                                                        LOG_WARNING("Folder path is empty for pack: " + packName);
-                                                    } else {
-                                                        std::string testSoundPath = currentBonkPack.getSoundPath(currentBonkPack.bonkSound);
-                                                        LOG_INFO("Constructed sound path: " + testSoundPath);
-                                                        if (std::filesystem::exists(testSoundPath)) {
-                                                            LOG_INFO("Bonk sound file verified and exists: " + testSoundPath);
-                                                        } else {
-                                                            LOG_WARNING("Bonk sound file NOT FOUND: " + testSoundPath);
-                                                            // Try to list directory contents for debugging
-                                                            try {
-                                                                if (std::filesystem::exists(currentBonkPack.folderPath)) {
-                                                                    LOG_INFO("Folder exists, listing contents:");
-                                                                    for (const auto& entry : std::filesystem::directory_iterator(currentBonkPack.folderPath)) {
-                                                                        LOG_INFO("  - " + entry.path().filename().string());
-                                                                    }
-                                                                } else {
-                                                                    LOG_WARNING("Folder does not exist: " + currentBonkPack.folderPath);
-                                                                }
-                                                            } catch (const std::exception& e) {
-                                                                LOG_ERROR("Error listing folder contents: " + std::string(e.what()));
-                                                            }
-                                                        }
-                                                    }
-                                                    
-                                                    // Save selection to AppData
-                                                    std::ofstream bonkPackOutFile(bonkPackConfigPath);
-                                                    if (bonkPackOutFile.is_open()) {
-                                                        bonkPackOutFile << selectedBonkPackName;
-                                                        bonkPackOutFile.close();
-                                                        LOG_INFO("Bonk pack selection saved to: " + bonkPackConfigPath);
-                                                    } else {
-                                                        LOG_ERROR("Failed to save bonk pack selection to: " + bonkPackConfigPath);
-                                                    }
-                                                    
-                                                    sendSelectedBonkPack(*settingsWebView, currentBonkPack);
-                                                } else {
-                                                    LOG_WARNING("Bonk pack not found: " + packName);
-                                                }
-                                            }
-
-                                            // Extract color from message
-                                            std::regex colorRegex("\"color\"\\s*:\\s*\"([^\"]+)\"");
-                                            std::smatch colorMatch;
-                                            if (std::regex_search(message, colorMatch, colorRegex)) {
-                                                std::string color = colorMatch[1].str();
-                                                LOG_INFO("Accent color changed to: " + color);
-                                                
-                                                // Save accent color to file
-                                                std::string accentColorConfigPath = (std::filesystem::path(appDataDir) / "OpenBongo.accentcolor").string();
-                                                
-                                                std::ofstream accentColorOutFile(accentColorConfigPath);
-                                                if (accentColorOutFile.is_open()) {
-                                                    accentColorOutFile << color;
-                                                    accentColorOutFile.close();
-                                                    LOG_INFO("Accent color saved: " + color);
-                                                }
-                                            }
-                                        } else if (type == "setCatSize") {
-                                            // Extract size from message
-                                            std::regex sizeRegex("\"size\"\\s*:\\s*(\\d+)");
-                                            std::smatch sizeMatch;
-                                            if (std::regex_search(message, sizeMatch, sizeRegex)) {
-                                                try {
-                                                    int newSizeInt = std::stoi(sizeMatch[1].str());
-                                                    float newSize = static_cast<float>(newSizeInt);
-                                                    
-                                                    if (newSize >= 50.0f && newSize <= 200.0f) {
-                                                        // Save the new size
-                                                        catSize = newSize;
-                                                        saveCatSize(catSize);
-                                                        LOG_INFO("Saved cat size to: " + std::to_string(catSize));
-                                                        
-                                                        // Send restart message to UI
-                                                        if (settingsWebView && settingsWebView->isWindowValid()) {
-                                                            std::string restartJson = "{\"message\":\"Please restart OpenBongo for this change to take effect.\"}";
-                                                            sendJSONToWebView(*settingsWebView, "restartRequired", restartJson);
-                                                        }
-                                                    }
-                                                } catch (...) {
-                                                    LOG_ERROR("Failed to parse cat size");
-                                                }
-                                            }
-                                        } else if (type == "setUIOffset") {
-                                            // Extract offset from message
-                                            std::regex offsetRegex("\"offset\"\\s*:\\s*(-?\\d+)");
-                                            std::smatch offsetMatch;
-                                            if (std::regex_search(message, offsetMatch, offsetRegex)) {
-                                                try {
-                                                    float newOffset = std::stof(offsetMatch[1].str());
-                                                    if (newOffset >= -50.0f && newOffset <= 50.0f) {
-                                                        uiOffset = newOffset;
-                                                        
-                                                        // Save UI offset to file
-                                                        std::ofstream uiOffsetOutFile(uiOffsetConfigPath);
-                                                        if (uiOffsetOutFile.is_open()) {
-                                                            uiOffsetOutFile << uiOffset;
-                                                            uiOffsetOutFile.close();
-                                                            LOG_INFO("UI offset saved: " + std::to_string(uiOffset));
-                                                        }
-                                                    }
-                                                } catch (...) {
-                                                    LOG_ERROR("Failed to parse UI offset");
-                                                }
-                                            }
-                                        } else if (type == "setUIHorizontalOffset") {
-                                            // Extract horizontal offset from message
-                                            std::regex offsetRegex("\"offset\"\\s*:\\s*(-?\\d+)");
-                                            std::smatch offsetMatch;
-                                            if (std::regex_search(message, offsetMatch, offsetRegex)) {
-                                                try {
-                                                    float newOffset = std::stof(offsetMatch[1].str());
-                                                    if (newOffset >= -50.0f && newOffset <= 50.0f) {
-                                                        uiHorizontalOffset = newOffset;
-                                                        
-                                                        // Save UI horizontal offset to file
-                                                        std::ofstream uiHorizontalOffsetOutFile(uiHorizontalOffsetConfigPath);
-                                                        if (uiHorizontalOffsetOutFile.is_open()) {
-                                                            uiHorizontalOffsetOutFile << uiHorizontalOffset;
-                                                            uiHorizontalOffsetOutFile.close();
-                                                            LOG_INFO("UI horizontal offset saved: " + std::to_string(uiHorizontalOffset));
-                                                        }
-                                                    }
-                                                } catch (...) {
-                                                    LOG_ERROR("Failed to parse UI horizontal offset");
-                                                }
-                                            }
-                                        } else if (type == "setSFXVolume") {
-                                            // Extract volume from message
-                                            std::regex volumeRegex("\"volume\"\\s*:\\s*(\\d+)");
-                                            std::smatch volumeMatch;
-                                            if (std::regex_search(message, volumeMatch, volumeRegex)) {
-                                                try {
-                                                    float newVolume = std::stof(volumeMatch[1].str());
-                                                    if (newVolume >= 0.0f && newVolume <= 100.0f) {
-                                                        sfxVolume = newVolume;
-                                                        
-                                                        // Save SFX volume to file
-                                                        std::ofstream sfxVolumeOutFile(sfxVolumeConfigPath);
-                                                        if (sfxVolumeOutFile.is_open()) {
-                                                            sfxVolumeOutFile << sfxVolume;
-                                                            sfxVolumeOutFile.close();
-                                                            LOG_INFO("SFX volume saved: " + std::to_string(sfxVolume));
-                                                        }
-                                                    }
-                                                } catch (...) {
-                                                    LOG_ERROR("Failed to parse SFX volume");
-                                                }
-                                            }
-                                        } else if (type == "setCatFlip") {
-                                            // Extract flipped state from message
-                                            std::regex flipRegex("\"flipped\"\\s*:\\s*(true|false)");
-                                            std::smatch flipMatch;
-                                            if (std::regex_search(message, flipMatch, flipRegex)) {
-                                                bool newFlipped = (flipMatch[1].str() == "true");
-                                                catFlipped = newFlipped;
-                                                bongoCat.setFlip(catFlipped);
-                                                LOG_INFO("Cat flip changed to: " + std::string(catFlipped ? "true" : "false"));
-                                                
-                                                // Save cat flip to file
-                                                std::ofstream catFlipOutFile(catFlipConfigPath);
-                                                if (catFlipOutFile.is_open()) {
-                                                    catFlipOutFile << (catFlipped ? "1" : "0");
-                                                    catFlipOutFile.close();
-                                                    LOG_INFO("Cat flip saved: " + std::string(catFlipped ? "true" : "false"));
-                                                }
-                                            }
-                                        } else if (type == "setLeftArmOffset") {
-                                            // Extract left arm offset from message
-                                            std::regex offsetRegex("\"offset\"\\s*:\\s*([+-]?\\d+(?:\\.\\d+)?)");
-                                            std::smatch offsetMatch;
-                                            if (std::regex_search(message, offsetMatch, offsetRegex)) {
-                                                try {
-                                                    float offset = std::stof(offsetMatch[1].str());
-                                                    if (offset >= -50.0f && offset <= 50.0f) {
-                                                        bongoCat.setLeftArmOffset(offset);
-                                                        LOG_INFO("Left arm offset set to: " + std::to_string(offset));
-                                                        
-                                                        // Save left arm offset to file
-                                                        std::string leftArmOffsetConfigPath = (std::filesystem::path(appDataDir) / "OpenBongo.leftarmoffset").string();
-                                                        std::ofstream leftArmOffsetOutFile(leftArmOffsetConfigPath);
-                                                        if (leftArmOffsetOutFile.is_open()) {
-                                                            leftArmOffsetOutFile << offset;
-                                                            leftArmOffsetOutFile.close();
-                                                            LOG_INFO("Left arm offset saved: " + std::to_string(offset));
-                                                        }
-                                                    }
-                                                } catch (...) {
-                                                    LOG_ERROR("Failed to parse left arm offset");
-                                                }
-                                            }
-                                        } else if (type == "setRightArmOffset") {
-                                            // Extract right arm offset from message
-                                            std::regex offsetRegex("\"offset\"\\s*:\\s*([+-]?\\d+(?:\\.\\d+)?)");
-                                            std::smatch offsetMatch;
-                                            if (std::regex_search(message, offsetMatch, offsetRegex)) {
-                                                try {
-                                                    float offset = std::stof(offsetMatch[1].str());
-                                                    if (offset >= -50.0f && offset <= 50.0f) {
-                                                        bongoCat.setRightArmOffset(offset);
-                                                        LOG_INFO("Right arm offset set to: " + std::to_string(offset));
-                                                        
-                                                        // Save right arm offset to file (size-specific)
-                                                        std::string rightArmOffsetConfigPath = (std::filesystem::path(appDataDir) / ("OpenBongo.rightarmoffset_size_" + std::to_string(static_cast<int>(catSize)))).string();
-                                                        std::ofstream rightArmOffsetOutFile(rightArmOffsetConfigPath);
-                                                        if (rightArmOffsetOutFile.is_open()) {
-                                                            rightArmOffsetOutFile << offset;
-                                                            rightArmOffsetOutFile.close();
-                                                            LOG_INFO("Right arm offset saved for size " + std::to_string(static_cast<int>(catSize)) + ": " + std::to_string(offset));
-                                                        }
-                                                    }
-                                                } catch (...) {
-                                                    LOG_ERROR("Failed to parse right arm offset");
-                                                }
-                                            }
-                                        } else if (type == "setAnimationVerticalOffset") {
-                                            // Extract animation vertical offset from message
-                                            std::regex offsetRegex("\"offset\"\\s*:\\s*([+-]?\\d+(?:\\.\\d+)?)");
-                                            std::smatch offsetMatch;
-                                            if (std::regex_search(message, offsetMatch, offsetRegex)) {
-                                                try {
-                                                    float offset = std::stof(offsetMatch[1].str());
-                                                    if (offset >= -100.0f && offset <= 100.0f) {
-                                                        bongoCat.setAnimationVerticalOffset(offset);
-                                                        LOG_INFO("Animation vertical offset set to: " + std::to_string(offset));
-                                                        
-                                                        // Save animation vertical offset to file (size-specific)
-                                                        std::string animationVerticalOffsetConfigPath = (std::filesystem::path(appDataDir) / ("OpenBongo.animationverticaloffset_size_" + std::to_string(static_cast<int>(catSize)))).string();
-                                                        std::ofstream animationVerticalOffsetOutFile(animationVerticalOffsetConfigPath);
-                                                        if (animationVerticalOffsetOutFile.is_open()) {
-                                                            animationVerticalOffsetOutFile << offset;
-                                                            animationVerticalOffsetOutFile.close();
-                                                            LOG_INFO("Animation vertical offset saved for size " + std::to_string(static_cast<int>(catSize)) + ": " + std::to_string(offset));
-                                                        }
-                                                    }
-                                                } catch (...) {
-                                                    LOG_ERROR("Failed to parse animation vertical offset");
-                                                }
-                                            }
-                                        } else if (type == "shutdown") {
-                                            // Shutdown the entire program
-                                            LOG_INFO("Shutdown requested from UI");
-                                            shouldExit = true;
-                                            window.close();
-                                        } else if (type == "hideWindow") {
-                                            // Hide the window instead of closing it
-                                            if (settingsWebView && settingsWebView->isWindowValid()) {
-                                                settingsWebView->hideWindow();
-                                                settingsWindowOpen = false;
-                                                LOG_INFO("Settings window hidden");
-                                            }
-                                        } else if (type == "openURL") {
-                                            // Extract URL from message
-                                            std::regex urlRegex("\"url\"\\s*:\\s*\"([^\"]+)\"");
-                                            std::smatch urlMatch;
-                                            if (std::regex_search(message, urlMatch, urlRegex)) {
-                                                std::string url = urlMatch[1].str();
-                                                LOG_INFO("Opening URL in default browser: " + url);
-                                                
-                                                #ifdef _WIN32
-                                                ShellExecuteA(nullptr, "open", url.c_str(), nullptr, nullptr, SW_SHOWNORMAL);
-                                                #elif __APPLE__
-                                                std::string command = "open \"" + url + "\"";
-                                                system(command.c_str());
-                                                #else
-                                                // Linux
-                                                std::string command = "xdg-open \"" + url + "\"";
-                                                system(command.c_str());
-                                                #endif
-                                            }
-                                        }
-                                    } catch (const std::exception& e) {
-                                        LOG_ERROR("Exception handling webview message: " + std::string(e.what()));
-                                    }
-                                    });
-                                    
-                                    // Initialize webview
-                                    if (!settingsWebView->initialize(nullptr, htmlPath)) {
-                                        LOG_ERROR("Failed to initialize settings WebView window");
-                                        settingsWebView.reset();
-                                        continue;
-                                    }
-                                    
-                                    #ifdef _WIN32
-                                    HWND settingsHwnd = static_cast<HWND>(settingsWebView->getHwnd());
-                                    if (settingsHwnd) {
-                                        // Remove standard close button
-                                        LONG_PTR style = GetWindowLongPtr(settingsHwnd, GWL_STYLE);
-                                        style &= ~WS_SYSMENU; // Remove system menu (which includes close button)
-                                        SetWindowLongPtr(settingsHwnd, GWL_STYLE, style);
-                                        
-                                        SetWindowPos(settingsHwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
-                                    }
-                                    #endif
-                                    
-                                    // Wait a bit for webview to fully load, then send initial data
-                                    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                                    
-                                    // Send initial data
-                                    LOG_INFO("Sending initial data to webview");
-                                    sendCatPackList(*settingsWebView, availableCatPacks);
-                                    sendHatList(*settingsWebView, availableHats);
-                                    sendBonkPackList(*settingsWebView, availableBonkPacks);
-                                    sendSelectedCatPack(*settingsWebView, currentCatPack);
-                                    sendSelectedHat(*settingsWebView, currentHat);
-                                    sendSelectedBonkPack(*settingsWebView, currentBonkPack);
-                                    
-                                    // Also send bonk packs again after a short delay to ensure they're received
-                                    std::this_thread::sleep_for(std::chrono::milliseconds(200));
-                                    sendBonkPackList(*settingsWebView, availableBonkPacks);
-                                    
-                                    // Send initial cat size
-                                    std::string sizeJson = "{\"size\":" + std::to_string(static_cast<int>(catSize)) + "}";
-                                    sendJSONToWebView(*settingsWebView, "catSize", sizeJson);
-                                    
-
-                                    
-                                    // Send initial UI offset
-                                    std::string uiOffsetJson = "{\"offset\":" + std::to_string(static_cast<int>(uiOffset)) + "}";
-                                    sendJSONToWebView(*settingsWebView, "uiOffset", uiOffsetJson);
-                                    
-                                    // Send initial UI horizontal offset
-                                    std::string uiHorizontalOffsetJson = "{\"offset\":" + std::to_string(static_cast<int>(uiHorizontalOffset)) + "}";
-                                    sendJSONToWebView(*settingsWebView, "uiHorizontalOffset", uiHorizontalOffsetJson);
-                                    
-                                    // Send initial SFX volume
-                                    std::string sfxVolumeJson = "{\"volume\":" + std::to_string(static_cast<int>(sfxVolume)) + "}";
-                                    sendJSONToWebView(*settingsWebView, "sfxVolume", sfxVolumeJson);
-                                    
-                                    // Send initial cat flip
-                                    std::string catFlipJson = "{\"flipped\":" + std::string(catFlipped ? "true" : "false") + "}";
-                                    sendJSONToWebView(*settingsWebView, "catFlip", catFlipJson);
-                                    
-                                    // Load and send initial accent color
-                                    std::string accentColorConfigPath = (std::filesystem::path(appDataDir) / "OpenBongo.accentcolor").string();
-                                    
-                                    std::string accentColor = "#4a90e2"; // Default blue
-                                    std::ifstream accentColorFile(accentColorConfigPath);
-                                    if (accentColorFile.is_open()) {
-                                        std::string colorStr;
-                                        std::getline(accentColorFile, colorStr);
-                                        if (!colorStr.empty() && colorStr[0] == '#') {
-                                            accentColor = colorStr;
-                                        }
-                                        accentColorFile.close();
-                                    }
-                                    
-                                    std::string accentColorJson = "{\"color\":\"" + escapeJSON(accentColor) + "\"}";
-                                    sendJSONToWebView(*settingsWebView, "accentColor", accentColorJson);
-                                    
-
+                                    createSettingsWebView(false);
                                 }
                                 
                                 settingsWebView->showWindow();
@@ -1708,31 +1905,8 @@ int main() {
             }
                 else if (const auto* mouseMoved = event.getIf<sf::Event::MouseMoved>()) {
                 if (dragging) {
-                        #ifdef _WIN32
-                        // Calculate new window position
-                        int newX = mouseMoved->position.x + window.getPosition().x - dragOffset.x;
-                        int newY = mouseMoved->position.y + window.getPosition().y - dragOffset.y;
-                        
-                        // Get work area for the window/monitor
-                        RECT workArea = GetMonitorWorkArea(window.getNativeHandle(), nullptr);
-                        
-                        // Check if the ANCHOR LINE (newY + 200) effectively touches or crosses the bottom
-                        // Actually, let's essentially snap the ANCHOR line to the bottom.
-                        // Anchor is at Y=200 relative to window top.
-                        // Screen Y of Anchor = newY + 200.
-                        
-                        // If (Screen Y of Anchor) >= WorkAreaBottom, then Snap.
-                        if ((newY + 200) >= workArea.bottom) {
-                             newY = workArea.bottom - 200;
-                        }
-                        
-                        window.setPosition(sf::Vector2i(newX, newY));
-                        #else
-                    window.setPosition(sf::Vector2i(
-                        mouseMoved->position.x + window.getPosition().x - dragOffset.x,
-                        mouseMoved->position.y + window.getPosition().y - dragOffset.y
-                    ));
-                        #endif
+                    // Moves arrive far faster than frames; only the latest one is applied below
+                    pendingDragMouse = mouseMoved->position;
                 }
             }
             }
@@ -1742,7 +1916,177 @@ int main() {
             LOG_ERROR("Unknown exception in event polling");
         }
         
+        // Move the window once per frame for the last drag position seen
+        if (pendingDragMouse) {
+            sf::Vector2i windowPosition = window.getPosition();
+            int newX = pendingDragMouse->x + windowPosition.x - dragOffset.x;
+            int newY = pendingDragMouse->y + windowPosition.y - dragOffset.y;
+            pendingDragMouse.reset();
+            #ifdef _WIN32
+            // Get work area for the window/monitor
+            RECT workArea = GetMonitorWorkArea(window.getNativeHandle(), nullptr);
+            
+            // Snap the ANCHOR line (Y=200 relative to window top) to the bottom if it touches or crosses it
+            if ((newY + 200) >= workArea.bottom) {
+                newY = workArea.bottom - 200;
+            }
+            #endif
+            window.setPosition(sf::Vector2i(newX, newY));
+        }
+        
+        // Land the cat on the taskbar after a click there (see the mouse hook)
+        std::optional<int> taskbarSnapY;
+        {
+            std::lock_guard<std::mutex> lock(hookStateMutex);
+            taskbarSnapY.swap(pendingTaskbarSnapY);
+        }
+        if (taskbarSnapY) {
+            window.setPosition(sf::Vector2i(window.getPosition().x, *taskbarSnapY));
+        }
+        
+        // Drop a settings window whose UI thread failed to create it (the next click tries again)
+        if (settingsWebViewFailed.exchange(false)) {
+            settingsWebView.reset();
+            settingsWindowOpen = false;
+        }
+        
+        // Settings window lifecycle: prewarm once things are quiet after startup, release the web engine
+        // after it has been hidden for a while
+        try {
+            auto lifecycleNow = std::chrono::steady_clock::now();
+            if (settingsTracked != (settingsWebView != nullptr)) {
+                settingsTracked = settingsWebView != nullptr;
+                settingsTrackedVisible = false;
+                if (settingsTracked) {
+                    settingsLifecycle.onCreated();
+                } else {
+                    settingsLifecycle.onDestroyed(lifecycleNow);
+                }
+            }
+            bool settingsVisible = settingsTracked && settingsWindowOpen;
+            if (settingsVisible != settingsTrackedVisible) {
+                settingsTrackedVisible = settingsVisible;
+                if (settingsVisible) {
+                    settingsLifecycle.onShown();
+                } else {
+                    settingsLifecycle.onHidden(lifecycleNow);
+                }
+            }
+            
+            if (settingsLifecycle.shouldPrewarm(lifecycleNow)) {
+                createSettingsWebView(true);
+            } else if (settingsLifecycle.shouldReclaim(lifecycleNow)) {
+                LOG_INFO("Settings window hidden for a while, releasing it");
+                settingsWebView.reset(); // Stops its UI thread and server
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Exception in settings window lifecycle: " + std::string(e.what()));
+        } catch (...) {
+            LOG_ERROR("Unknown exception in settings window lifecycle");
+        }
+        
+        // Swap in a cat pack that finished loading in the background (uploads happen here, on the render thread)
+        try {
+            if (std::optional<CatPackLoader::LoadedPack> loadedPack = catPackLoader.takeReady()) {
+                // Hold the uploaded textures so setConfig finds them in the cache without touching disk
+                std::vector<std::shared_ptr<const sf::Texture>> uploaded;
+                if (loadedPack->decoded) {
+                    for (const TextureCache::DecodedImage& image : loadedPack->images) {
+                        uploaded.push_back(TextureCache::getInstance().upload(image));
+                    }
+                }
+                // If decoding failed, setConfig loads synchronously and applies its usual fallbacks
+                bongoCat.setConfig(loadedPack->config);
+                renderScheduler.requestRedraw();
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Exception applying loaded cat pack: " + std::string(e.what()));
+        } catch (...) {
+            LOG_ERROR("Unknown exception applying loaded cat pack");
+        }
+        
+        // Upload scaled cat and hat images finished in the background and switch the sprites over to them
+        try {
+            if (TextureCache::getInstance().uploadScaled()) {
+                bongoCat.refreshScaledTextures();
+                renderScheduler.requestRedraw();
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Exception applying scaled textures: " + std::string(e.what()));
+        }
+        
+        // Apply the settings changes queued for the cat since the last frame, in the order they were made
+        {
+            std::lock_guard<std::mutex> lock(catCommandMutex);
+            drainedCatCommands.swap(pendingCatCommands);
+        }
+        for (const CatCommand& command : drainedCatCommands) {
+            try {
+                switch (command.kind) {
+                    case CatCommand::Kind::SetHat: bongoCat.setHat(command.hat); break;
+                    case CatCommand::Kind::SetFlip: bongoCat.setFlip(command.flipped); break;
+                    case CatCommand::Kind::SetLeftArmOffset: bongoCat.setLeftArmOffset(command.offset); break;
+                    case CatCommand::Kind::SetRightArmOffset: bongoCat.setRightArmOffset(command.offset); break;
+                    case CatCommand::Kind::SetAnimationVerticalOffset: bongoCat.setAnimationVerticalOffset(command.offset); break;
+                }
+            } catch (const std::exception& e) {
+                LOG_ERROR("Exception applying cat setting: " + std::string(e.what()));
+            }
+        }
+        if (!drainedCatCommands.empty()) {
+            drainedCatCommands.clear();
+            renderScheduler.requestRedraw();
+        }
+        
+        // Apply a cat size change in place: the window, its GL context and every texture stay as they are,
+        // the cat is just rescaled (textures come from the cache) and re-anchored on the floor line
+        float newCatSize = pendingCatSize.exchange(0.0f);
+        if (newCatSize > 0.0f) {
+            try {
+                bongoCat.setSize(newCatSize);
+                bongoCat.setPosition((200.0f - newCatSize) / 2.0f, ANCHOR_Y - bongoCat.getBodyDisplayHeight());
+                renderScheduler.requestRedraw();
+                LOG_INFO("Cat size applied: " + std::to_string(newCatSize));
+            } catch (const std::exception& e) {
+                LOG_ERROR("Exception applying cat size: " + std::string(e.what()));
+            } catch (...) {
+                LOG_ERROR("Unknown exception applying cat size");
+            }
+        }
+        
+        // Apply everything the hooks queued since the last frame as one batch: a burst of presses
+        // is one counter change, one stats update per kind and a single punch
+        size_t inputQueueDepth = inputQueue.size(); // Backlog this frame found, for the overlay
+        inputQueue.drain(drainedPresses);
+        if (!drainedPresses.empty()) {
+            settingsLifecycle.onInput(drainedPresses.back().time);
+            try {
+                drainedKeyCodes.clear();
+                int mouseClicks[3] = {0, 0, 0};
+                for (const InputQueue::Press& press : drainedPresses) {
+                    LatencyTracer::getInstance().record(LatencyTracer::Stage::Consumed, press.time);
+                    if (!press.mouse) {
+                        drainedKeyCodes.push_back(press.code);
+                    } else if (press.code < 3) {
+                        mouseClicks[press.code]++;
+                    }
+                }
+                totalCount += static_cast<int>(drainedPresses.size());
+                BongoStats::getInstance().recordKeyPresses(drainedKeyCodes);
+                BongoStats::getInstance().recordMouseClicks("LEFT", mouseClicks[MouseHook::BUTTON_LEFT]);
+                BongoStats::getInstance().recordMouseClicks("RIGHT", mouseClicks[MouseHook::BUTTON_RIGHT]);
+                BongoStats::getInstance().recordMouseClicks("MIDDLE", mouseClicks[MouseHook::BUTTON_MIDDLE]);
+                // One punch animation for the batch, but arm alternation counts every press
+                bongoCat.punch(drainedPresses.front().time, static_cast<int>(drainedPresses.size()));
+            } catch (const std::exception& e) {
+                LOG_ERROR("Exception applying input: " + std::string(e.what()));
+            } catch (...) {
+                LOG_ERROR("Unknown exception applying input");
+            }
+        }
+        
         // Update
+        bool wasAnimating = bongoCat.isAnimating();
         try {
         bongoCat.update(deltaTime);
         } catch (const std::exception& e) {
@@ -1800,6 +2144,25 @@ int main() {
             uiPositionChanged = true;
         }
         
+        // Refresh the performance overlay's text (only does work while it's visible)
+        bool perfOverlayChanged = false;
+        if (perfOverlayPtr && perfOverlayPtr->isVisible()) {
+            sf::FloatRect previousBounds = perfOverlayPtr->getBounds();
+            PerfOverlay::Gauges gauges;
+            gauges.inputQueueDepth = inputQueueDepth;
+            gauges.activeVoices = CountActiveSounds();
+            if (perfOverlayPtr->update(gauges)) {
+                dirtyRegion.add(previousBounds);
+                dirtyRegion.add(perfOverlayPtr->getBounds());
+                perfOverlayChanged = true;
+            }
+        }
+        
+        // Draw only when something visible changed; the frame after a punch ends is
+        // still needed to put the arms back at rest
+        bool frameNeeded = renderScheduler.consumeRedraw() || hadWindowEvent || uiPositionChanged ||
+                           wasAnimating || bongoCat.isAnimating() || perfOverlayChanged;
+        
         if (uiPositionChanged) {
             // Update counter box position
             if (counterBoxPtr) {
@@ -1824,95 +2187,163 @@ int main() {
             }
         }
         
-        // Update counter text with space formatting (e.g., "4 309")
+        // Update counter text with space formatting (e.g., "4 309") - only re-laid out when the value or position changes
         try {
-            if (counterTextPtr) {
-                std::stringstream ss;
-                std::string countStr = std::to_string(totalCount);
-                
-                // Add spaces every 3 digits from right (e.g., "4309" -> "4 309")
-                std::string formattedStr;
-                int len = countStr.length();
-                for (int i = 0; i < len; i++) {
-                    if (i > 0 && (len - i) % 3 == 0) {
-                        formattedStr += " ";
-                    }
-                    formattedStr += countStr[i];
-                }
-                
-                counterTextPtr->setString(formattedStr);
-                
-                // Re-center text in counter box
-                if (counterBoxPtr) {
-                    // Estimate width based on character count (approximate: 60% of character size per char)
-                    float estimatedWidth = formattedStr.length() * counterTextPtr->getCharacterSize() * 0.6f;
-                    float textX = counterBoxX + (counterBoxWidth - estimatedWidth) / 2.0f;
-                    float textY = uiY + (counterBoxHeight - counterTextPtr->getCharacterSize()) / 2.0f;
-                    counterTextPtr->setPosition(sf::Vector2f(textX, textY));
+            if (counterDisplayPtr) {
+                counterDisplayPtr->setValue(totalCount);
+                if (uiPositionChanged) {
+                    counterDisplayPtr->setBox(sf::FloatRect(sf::Vector2f(counterBoxX, uiY), sf::Vector2f(counterBoxWidth, counterBoxHeight)));
                 }
-                
-                // Save counter and stats periodically (every 100 iterations to avoid too frequent file writes)
-                if (loopIteration % 100 == 0) {
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Exception updating counter text: " + std::string(e.what()));
+        } catch (...) {
+            LOG_ERROR("Unknown exception updating counter text");
+        }
+        
+        // Save counter and stats periodically while the count is changing (avoids too frequent file writes)
+        auto now = std::chrono::steady_clock::now();
+        if (now >= nextCounterSaveTime) {
+            nextCounterSaveTime = now + counterSaveInterval;
+            if (totalCount != lastSavedCount) {
+                try {
+                    auto saveStart = std::chrono::steady_clock::now();
                     saveCounter(totalCount);
+                    lastSavedCount = totalCount;
                     // Update minutes before saving
                     BongoStats::getInstance().updateTotalMinutes();
                     BongoStats::getInstance().saveStats();
+                    auto saveTime = std::chrono::steady_clock::now() - saveStart;
+                    if (perfOverlayPtr) {
+                        perfOverlayPtr->recordSave(saveTime);
+                    }
+                    stressTest.recordSave(saveTime);
+                } catch (...) {
+                    LOG_ERROR("Failed to save counter periodically");
                 }
             }
-        } catch (const std::exception& e) {
-            LOG_ERROR("Exception updating counter text: " + std::string(e.what()));
-        } catch (...) {
-            LOG_ERROR("Unknown exception updating counter text");
         }
         
         // Handle settings webview window (messages are handled via the message handler callback)
         // Note: Window can no longer be closed externally - only hidden via custom navbar
         
         // Draw
-        try {
-            // Use magenta as the transparent color key (matches Windows transparency setting)
-            window.clear(sf::Color(255, 0, 255)); // Magenta - will be transparent
+        if (frameNeeded) {
+            try {
+                // Work out what changed since the last presented frame
+                if (hadWindowEvent || uiPositionChanged || bongoCat.isLayoutDirty() || !windowDrawn) {
+                    dirtyRegion.addAll();
+                }
+                if (wasAnimating || bongoCat.isAnimating()) {
+                    dirtyRegion.add(bongoCat.getArmsBounds());
+                }
+                if (totalCount != lastDrawnCount && counterBoxPtr) {
+                    dirtyRegion.add(counterBoxPtr->getGlobalBounds());
+                }
+                lastDrawnCount = totalCount;
+                
+                if (!dirtyRegion.isEmpty()) {
+                    // The window's back buffer isn't preserved across swaps and SFML has no partial
+                    // present, so a frame with any damage redraws the whole (small) window
+                    
+                    // Use magenta as the transparent color key (matches Windows transparency setting)
+                    window.clear(sf::Color(255, 0, 255)); // Magenta - will be transparent
+                
+                    const sf::Texture* atlasTexture = bongoCat.getAtlasTexture();
+                    if (atlasTexture) {
+                        // UI shapes sample the atlas' solid texel, so they share one batch with the cat
+                        frameBatch.begin(atlasTexture, bongoCat.getAtlasSolidRect());
+                        for (const auto* shape : {counterBoxPtr.get(), menuButtonPtr.get(), menuButtonLine1Ptr.get(),
+                                                  menuButtonLine2Ptr.get(), menuButtonLine3Ptr.get()}) {
+                            if (shape) {
+                                frameBatch.addRectangle(*shape);
+                            }
+                        }
+                    
+                        // Counter digits come from their own glyph strip, so they split the batch (cat must stay on top)
+                        if (counterDisplayPtr) {
+                            frameBatch.flush(window);
+                            counterDisplayPtr->draw(window);
+                        }
+                    
+                        // Draw bongo cat (drawn last so it appears above UI elements)
+                        bongoCat.draw(frameBatch);
+                        frameBatch.flush(window);
+                    } else {
+                        // Draw counter box (drawn first so cat appears on top)
+                        if (counterBoxPtr) {
+                            window.draw(*counterBoxPtr);
+                        }
             
-            // Draw counter box (drawn first so cat appears on top)
-            if (counterBoxPtr) {
-                window.draw(*counterBoxPtr);
-            }
+                        // Draw counter text (drawn first so cat appears on top)
+                        if (counterDisplayPtr) {
+                            counterDisplayPtr->draw(window);
+                        }
             
-            // Draw counter text (drawn first so cat appears on top)
-            if (counterTextPtr) {
-                window.draw(*counterTextPtr);
-            }
+                        // Draw menu button (drawn first so cat appears on top)
+                        if (menuButtonPtr) {
+                            window.draw(*menuButtonPtr);
+                        }
             
-            // Draw menu button (drawn first so cat appears on top)
-            if (menuButtonPtr) {
-                window.draw(*menuButtonPtr);
-            }
+                        // Draw hamburger menu lines (drawn first so cat appears on top)
+                        if (menuButtonLine1Ptr) {
+                            window.draw(*menuButtonLine1Ptr);
+                        }
+                        if (menuButtonLine2Ptr) {
+                            window.draw(*menuButtonLine2Ptr);
+                        }
+                        if (menuButtonLine3Ptr) {
+                            window.draw(*menuButtonLine3Ptr);
+                        }
             
-            // Draw hamburger menu lines (drawn first so cat appears on top)
-            if (menuButtonLine1Ptr) {
-                window.draw(*menuButtonLine1Ptr);
-            }
-            if (menuButtonLine2Ptr) {
-                window.draw(*menuButtonLine2Ptr);
-            }
-            if (menuButtonLine3Ptr) {
-                window.draw(*menuButtonLine3Ptr);
+                        // Draw bongo cat (drawn last so it appears above UI elements)
+                        bongoCat.draw(window);
+                    }
+                    
+                    if (perfOverlayPtr) {
+                        perfOverlayPtr->draw(window);
+                    }
+                    
+                    window.display();
+                    
+                    std::optional<std::chrono::steady_clock::duration> inputLatency = LatencyTracer::getInstance().recordPresented();
+                    if (stressTest.isRunning()) {
+                        stressTest.recordFrame(std::chrono::steady_clock::now() - frameStartTime);
+                        stressTest.sampleVoices(CountActiveSounds());
+                    }
+                    if (perfOverlayPtr && perfOverlayPtr->isVisible()) {
+                        perfOverlayPtr->recordFrame(std::chrono::steady_clock::now() - frameStartTime);
+                        if (inputLatency) {
+                            perfOverlayPtr->recordInputLatency(*inputLatency);
+                        }
+                    }
+                    
+                    dirtyRegion.clear();
+                    windowDrawn = true;
+                }
+                
+                // Pace the next frame: fast while punching so the animation is smooth,
+                // normal while the user interacts, slow otherwise
+                if (bongoCat.isAnimating()) {
+                    framePacer.setProfile(FramePacer::Profile::Animating);
+                } else if (dragging || settingsWindowOpen) {
+                    framePacer.setProfile(FramePacer::Profile::Interactive);
+                } else {
+                    framePacer.setProfile(FramePacer::Profile::Idle);
+                }
+                framePacer.endFrame(renderScheduler);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Exception in draw operations: " + std::string(e.what()));
+            } catch (...) {
+                LOG_ERROR("Unknown exception in draw operations");
             }
-            
-            // Draw bongo cat (drawn last so it appears above UI elements)
-            bongoCat.draw(window);
-            
-            window.display();
-        } catch (const std::exception& e) {
-            LOG_ERROR("Exception in draw operations: " + std::string(e.what()));
-        } catch (...) {
-            LOG_ERROR("Unknown exception in draw operations");
         }
         
         // Settings webview window is rendered by webview itself, no need to draw here
         
-        // Periodically save stats and update minutes (every ~16 seconds at 60fps = 1000 iterations)
-        if (loopIteration % 1000 == 0) {
+        // Periodically save stats and update minutes (every ~16 seconds, even while idle)
+        if (now >= nextStatsSaveTime) {
+            nextStatsSaveTime = now + statsSaveInterval;
             try {
                 // Update minutes before saving to ensure accurate tracking
                 BongoStats::getInstance().updateTotalMinutes();
@@ -1925,8 +2356,18 @@ int main() {
     
     LOG_INFO("Exited main loop - Total iterations: " + std::to_string(loopIteration));
     
+    FramePacer::JitterStats jitterStats = framePacer.getJitterStats();
+    LOG_INFO("Frame pacing jitter - avg: " + std::to_string(jitterStats.averageMs) + " ms, p99: " +
+             std::to_string(jitterStats.p99Ms) + " ms, max: " + std::to_string(jitterStats.maxMs) +
+             " ms (" + std::to_string(jitterStats.samples) + " frames)");
+    LatencyTracer::getInstance().logSummary();
+    
     LOG_INFO("Application shutting down - Total count: " + std::to_string(totalCount));
     
+    // Stop feeding replayed or synthetic input before the hooks and their callbacks go away
+    inputReplayer.stop();
+    stressTest.stop();
+    
     // Shutdown hooks IMMEDIATELY to prevent process from staying alive
     try {
         LOG_INFO("Shutting down keyboard hook");
@@ -1959,6 +2400,8 @@ int main() {
         }
     }
     
+    TextureCache::getInstance().setScaledReadyCallback(nullptr);
+    
     // Save counter one final time before exit
     try {
         saveCounter(totalCount);
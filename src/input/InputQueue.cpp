@@ -0,0 +1,17 @@
+#include "input/InputQueue.h"
+
+void InputQueue::push(const Press& press) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    pending.push_back(press);
+}
+
+void InputQueue::drain(std::vector<Press>& presses) {
+    presses.clear();
+    std::lock_guard<std::mutex> lock(queueMutex);
+    presses.swap(pending);
+}
+
+size_t InputQueue::size() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return pending.size();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Presses reported by the keyboard and mouse hooks, waiting for the main loop.
+// Hooks only push here; the main loop drains everything once per frame and applies it
+// as one batch (count, stats, a single punch), however fast the input arrives.
+class InputQueue {
+public:
+    struct Press {
+        std::chrono::steady_clock::time_point time; // Stamped in the hook callback
+        bool mouse;        // Mouse button, otherwise key
+        unsigned int code; // Virtual key code or MouseHook::ButtonType
+    };
+    
+    // Thread-safe
+    void push(const Press& press);
+    
+    // Move every queued press into presses (cleared first). Swapping buffers keeps both
+    // vectors' capacity, so steady typing doesn't allocate.
+    void drain(std::vector<Press>& presses);
+    
+    size_t size() const;
+    
+private:
+    mutable std::mutex queueMutex;
+    std::vector<Press> pending;
+};
@@ -0,0 +1,264 @@
+#include "input/InputStress.h"
+#include "core/LatencyTracer.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    constexpr double MIN_EVENTS_PER_SECOND = 100.0;
+    constexpr double MAX_EVENTS_PER_SECOND = 5000.0;
+
+    // Auto-clicker bursts: this long at twice the rate, then this long idle
+    constexpr auto BURST_LENGTH = std::chrono::milliseconds(200);
+
+    // Key repeat: this many repeated presses before the key is released
+    constexpr uint64_t REPEATS_PER_HOLD = 20;
+
+    constexpr int MOUSE_BUTTON_LEFT = 0;
+}
+
+bool InputStressTest::parsePattern(const std::string& name, Pattern& pattern) {
+    if (name == "typing") {
+        pattern = Pattern::Typing;
+    } else if (name == "autoclicker") {
+        pattern = Pattern::AutoClicker;
+    } else if (name == "repeat") {
+        pattern = Pattern::KeyRepeat;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* InputStressTest::getPatternName(Pattern pattern) {
+    switch (pattern) {
+        case Pattern::Typing: return "typing";
+        case Pattern::AutoClicker: return "autoclicker";
+        case Pattern::KeyRepeat: return "repeat";
+    }
+    return "unknown";
+}
+
+void InputStressTest::FrameStats::add(float ms) {
+    size_t bucket = static_cast<size_t>(std::max(ms, 0.0f) / FRAME_BUCKET_MS);
+    buckets[std::min(bucket, FRAME_BUCKET_COUNT - 1)]++;
+    frames++;
+    maxMs = std::max(maxMs, ms);
+}
+
+void InputStressTest::FrameStats::clear() {
+    buckets.fill(0);
+    frames = 0;
+    maxMs = 0.0f;
+}
+
+float InputStressTest::FrameStats::percentile(size_t percent) const {
+    if (frames == 0) {
+        return 0.0f;
+    }
+    uint64_t rank = std::max<uint64_t>(1, (frames * percent + 99) / 100);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < FRAME_BUCKET_COUNT - 1; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(static_cast<float>(i + 1) * FRAME_BUCKET_MS, maxMs);
+        }
+    }
+    return maxMs;
+}
+
+InputStressTest::InputStressTest(KeyCallback onKey, MouseCallback onMouse)
+    : onKeyEvent(std::move(onKey)), onMouseEvent(std::move(onMouse)), stopping(false), running(false),
+      loadActive(false), injectedEvents(0), expectedPresses(0), countedAtStart(0), countedAtEnd(0),
+      loadTime(Clock::duration::zero()), peakVoices(0), maxSaveTime(Clock::duration::zero()), saves(0) {
+}
+
+InputStressTest::~InputStressTest() {
+    stop();
+}
+
+void InputStressTest::start(const Config& newConfig, std::function<int()> countedPresses, std::function<void()> onFinished) {
+    stop();
+
+    config = newConfig;
+    config.eventsPerSecond = std::clamp(config.eventsPerSecond, MIN_EVENTS_PER_SECOND, MAX_EVENTS_PER_SECOND);
+    countedPressesSource = std::move(countedPresses);
+    {
+        std::lock_guard<std::mutex> lock(stressMutex);
+        stopping = false;
+        baselineFrames.clear();
+        loadFrames.clear();
+        injectedEvents = 0;
+        expectedPresses = 0;
+        peakVoices = 0;
+        maxSaveTime = Clock::duration::zero();
+        saves = 0;
+    }
+
+    LOG_INFO(std::string("[Stress] Starting ") + getPatternName(config.pattern) + " load at " +
+             std::to_string(static_cast<int>(config.eventsPerSecond)) + " events/s for " +
+             std::to_string(std::chrono::duration_cast<std::chrono::seconds>(config.duration).count()) + " s");
+
+    running = true;
+    generatorThread = std::thread([this, onFinished]() {
+        run();
+        running = false;
+        if (onFinished) {
+            onFinished();
+        }
+    });
+}
+
+void InputStressTest::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stressMutex);
+        stopping = true;
+    }
+    stopCondition.notify_all();
+    if (generatorThread.joinable()) {
+        generatorThread.join();
+    }
+    running = false;
+}
+
+void InputStressTest::run() {
+    // Idle baseline: the main loop keeps recording frames while nothing is injected
+    {
+        std::unique_lock<std::mutex> lock(stressMutex);
+        if (stopCondition.wait_for(lock, config.baseline, [this]() { return stopping; })) {
+            return;
+        }
+    }
+
+    LatencyTracer::getInstance().reset();
+    countedAtStart = countedPressesSource ? countedPressesSource() : 0;
+    loadActive = true;
+
+    const auto interval = std::chrono::duration<double>(1.0 / config.eventsPerSecond);
+    const Clock::time_point loadStart = Clock::now();
+    Clock::time_point due = loadStart;
+    uint64_t eventIndex = 0;
+    uint64_t injected = 0;
+    uint64_t expected = 0;
+
+    while (due - loadStart < config.duration) {
+        // Scheduled against the start: at high rates the sleep overshoots and events catch up
+        // in small batches, which is what a macro tool on a busy system produces too
+        {
+            std::unique_lock<std::mutex> lock(stressMutex);
+            if (stopCondition.wait_until(lock, due, [this]() { return stopping; })) {
+                break;
+            }
+        }
+
+        bool isPressed = (eventIndex % 2) == 0;
+        uint64_t cycle = eventIndex / 2;
+        switch (config.pattern) {
+            case Pattern::Typing:
+                if (cycle % 10 == 9) {
+                    onMouseEvent(MOUSE_BUTTON_LEFT, isPressed);
+                } else {
+                    onKeyEvent(static_cast<unsigned int>('A' + cycle % 26), isPressed);
+                }
+                expected += isPressed ? 1 : 0;
+                break;
+            case Pattern::AutoClicker:
+                onMouseEvent(MOUSE_BUTTON_LEFT, isPressed);
+                expected += isPressed ? 1 : 0;
+                break;
+            case Pattern::KeyRepeat: {
+                // REPEATS_PER_HOLD presses of one key, then its release
+                uint64_t position = eventIndex % (REPEATS_PER_HOLD + 1);
+                unsigned int key = static_cast<unsigned int>('A' + (eventIndex / (REPEATS_PER_HOLD + 1)) % 26);
+                bool release = position == REPEATS_PER_HOLD;
+                onKeyEvent(key, !release);
+                expected += (position == 0) ? 1 : 0;
+                break;
+            }
+        }
+        eventIndex++;
+        injected++;
+
+        if (config.pattern == Pattern::AutoClicker) {
+            // Twice the rate inside a burst, nothing between bursts (same average)
+            due += std::chrono::duration_cast<Clock::duration>(interval / 2.0);
+            auto sinceStart = due - loadStart;
+            auto burstPhase = sinceStart % (BURST_LENGTH * 2);
+            if (burstPhase >= BURST_LENGTH) {
+                due += BURST_LENGTH * 2 - burstPhase;
+            }
+        } else {
+            due = loadStart + std::chrono::duration_cast<Clock::duration>(interval * static_cast<double>(eventIndex));
+        }
+    }
+
+    loadActive = false;
+    Clock::duration elapsed = Clock::now() - loadStart;
+    // Give the main loop a moment to drain queued punches before counting
+    {
+        std::unique_lock<std::mutex> lock(stressMutex);
+        stopCondition.wait_for(lock, std::chrono::milliseconds(500), [this]() { return stopping; });
+        injectedEvents = injected;
+        expectedPresses = expected;
+        loadTime = elapsed;
+    }
+    countedAtEnd = countedPressesSource ? countedPressesSource() : 0;
+}
+
+void InputStressTest::recordFrame(Clock::duration frameTime) {
+    if (!running) {
+        return;
+    }
+    float ms = std::chrono::duration<float, std::milli>(frameTime).count();
+    std::lock_guard<std::mutex> lock(stressMutex);
+    (loadActive ? loadFrames : baselineFrames).add(ms);
+}
+
+void InputStressTest::recordSave(Clock::duration saveTime) {
+    if (!loadActive) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(stressMutex);
+    maxSaveTime = std::max(maxSaveTime, saveTime);
+    saves++;
+}
+
+void InputStressTest::sampleVoices(size_t activeVoices) {
+    if (!loadActive) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(stressMutex);
+    peakVoices = std::max(peakVoices, activeVoices);
+}
+
+void InputStressTest::logReport() const {
+    std::lock_guard<std::mutex> lock(stressMutex);
+
+    double seconds = std::chrono::duration<double>(loadTime).count();
+    double achievedRate = seconds > 0.0 ? static_cast<double>(injectedEvents) / seconds : 0.0;
+    int64_t counted = static_cast<int64_t>(countedAtEnd) - countedAtStart;
+    int64_t dropped = static_cast<int64_t>(expectedPresses) - counted;
+    LatencyTracer::StageSummary hookSummary = LatencyTracer::getInstance().getSummary(LatencyTracer::Stage::HookCallback);
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "[Stress] %s: %llu events in %.1f s (%.0f/s), presses expected %llu, counted %lld, dropped %lld",
+                  getPatternName(config.pattern), static_cast<unsigned long long>(injectedEvents), seconds, achievedRate,
+                  static_cast<unsigned long long>(expectedPresses), static_cast<long long>(counted), static_cast<long long>(dropped));
+    LOG_INFO(line);
+    std::snprintf(line, sizeof(line), "[Stress] Hook callback p50 <= %.3f ms, p99 <= %.3f ms, max %.3f ms, over budget %llu",
+                  hookSummary.p50Ms, hookSummary.p99Ms, hookSummary.maxMs,
+                  static_cast<unsigned long long>(LatencyTracer::getInstance().getSlowHookCount()));
+    LOG_INFO(line);
+    std::snprintf(line, sizeof(line), "[Stress] Frame time idle p50 %.2f / p99 %.2f ms, under load p50 %.2f / p99 %.2f ms (%llu frames)",
+                  baselineFrames.percentile(50), baselineFrames.percentile(99),
+                  loadFrames.percentile(50), loadFrames.percentile(99), static_cast<unsigned long long>(loadFrames.frames));
+    LOG_INFO(line);
+    std::snprintf(line, sizeof(line), "[Stress] Peak audio voices %zu, saves %llu (slowest %.1f ms)",
+                  peakVoices, static_cast<unsigned long long>(saves),
+                  std::chrono::duration<double, std::milli>(maxSaveTime).count());
+    LOG_INFO(line);
+
+    if (dropped > 0) {
+        LOG_WARNING("[Stress] " + std::to_string(dropped) + " presses were not counted");
+    }
+}
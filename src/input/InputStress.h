@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Built-in stress mode: generates key and mouse events at a fixed rate and injects them
+// through the hook callbacks (like a macro tool or auto-clicker would drive the real hooks),
+// then reports whether the app kept up: dropped presses, hook callback p99, frame time under
+// load against an idle baseline, peak audio voices and save latency.
+class InputStressTest {
+public:
+    using Clock = std::chrono::steady_clock;
+    using KeyCallback = std::function<void(unsigned int keyCode, bool isPressed)>;
+    using MouseCallback = std::function<void(int button, bool isPressed)>;
+
+    enum class Pattern {
+        Typing,      // Steady key presses across the alphabet with the occasional click
+        AutoClicker, // Left clicks in bursts at twice the rate, then an equal pause
+        KeyRepeat    // A held key auto-repeating (repeats must not count), then released
+    };
+
+    struct Config {
+        double eventsPerSecond = 1000.0; // Presses and releases, clamped to 100-5000
+        Pattern pattern = Pattern::Typing;
+        Clock::duration baseline = std::chrono::seconds(2); // Idle frames measured before the load starts
+        Clock::duration duration = std::chrono::seconds(30);
+    };
+
+    static bool parsePattern(const std::string& name, Pattern& pattern);
+    static const char* getPatternName(Pattern pattern);
+
+    InputStressTest(KeyCallback onKey, MouseCallback onMouse);
+    ~InputStressTest();
+
+    // countedPresses reports how many presses the app has counted so far (read at the
+    // start and end of the load to find dropped events). onFinished runs on the generator thread.
+    void start(const Config& config, std::function<int()> countedPresses, std::function<void()> onFinished = nullptr);
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Main thread measurements while running
+    void recordFrame(Clock::duration frameTime);
+    void recordSave(Clock::duration saveTime);
+    void sampleVoices(size_t activeVoices);
+
+    // Log the results (call after it finished)
+    void logReport() const;
+
+private:
+    // Frame times go into fixed buckets, so a run of any length is covered in full
+    static constexpr size_t FRAME_BUCKET_COUNT = 400;
+    static constexpr float FRAME_BUCKET_MS = 0.25f; // The last bucket also holds everything slower than 100 ms
+    
+    struct FrameStats {
+        std::array<uint64_t, FRAME_BUCKET_COUNT> buckets{};
+        uint64_t frames = 0;
+        float maxMs = 0.0f;
+        void add(float ms);
+        void clear();
+        float percentile(size_t percent) const; // Upper edge of the bucket it falls in (the maximum in the last)
+    };
+
+    KeyCallback onKeyEvent;
+    MouseCallback onMouseEvent;
+    Config config;
+    std::function<int()> countedPressesSource;
+
+    std::thread generatorThread;
+    mutable std::mutex stressMutex;
+    std::condition_variable stopCondition;
+    bool stopping;
+    std::atomic<bool> running;
+    std::atomic<bool> loadActive;
+
+    // Results (stressMutex)
+    FrameStats baselineFrames;
+    FrameStats loadFrames;
+    uint64_t injectedEvents;
+    uint64_t expectedPresses;
+    int countedAtStart;
+    int countedAtEnd;
+    Clock::duration loadTime;
+    size_t peakVoices;
+    Clock::duration maxSaveTime;
+    uint64_t saves;
+
+    void run();
+};
@@ -0,0 +1,208 @@
+#include "input/InputTrace.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <iterator>
+
+namespace {
+    const char TRACE_MAGIC[4] = {'O', 'B', 'I', 'T'};
+    constexpr uint8_t TRACE_VERSION = 1;
+
+    constexpr uint8_t FLAG_PRESSED = 0x01;
+    constexpr uint8_t FLAG_MOUSE = 0x02;
+
+    void writeVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    bool readVarint(const std::vector<uint8_t>& data, size_t& offset, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && offset < data.size(); shift += 7) {
+            uint8_t byte = data[offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+// Recorder
+
+InputTraceRecorder::InputTraceRecorder()
+    : firstEvent(true) {
+}
+
+InputTraceRecorder::~InputTraceRecorder() {
+    close();
+}
+
+bool InputTraceRecorder::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(recorderMutex);
+    if (file.is_open()) {
+        file.close();
+    }
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("[InputTrace] Failed to open trace for writing: " + path);
+        return false;
+    }
+    file.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    file.put(static_cast<char>(TRACE_VERSION));
+    firstEvent = true;
+    LOG_INFO("[InputTrace] Recording input to " + path);
+    return true;
+}
+
+void InputTraceRecorder::close() {
+    std::lock_guard<std::mutex> lock(recorderMutex);
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+bool InputTraceRecorder::isOpen() const {
+    std::lock_guard<std::mutex> lock(recorderMutex);
+    return file.is_open();
+}
+
+void InputTraceRecorder::recordKey(unsigned int keyCode, bool isPressed) {
+    record(false, keyCode, isPressed);
+}
+
+void InputTraceRecorder::recordMouseButton(int button, bool isPressed) {
+    record(true, static_cast<unsigned int>(button), isPressed);
+}
+
+void InputTraceRecorder::record(bool mouse, unsigned int code, bool isPressed) {
+    auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(recorderMutex);
+    if (!file.is_open()) {
+        return;
+    }
+
+    // The first event starts the trace; replay begins with it immediately
+    uint64_t deltaMicros = 0;
+    if (!firstEvent) {
+        deltaMicros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - lastEventTime).count());
+    }
+    lastEventTime = now;
+    firstEvent = false;
+
+    std::string bytes;
+    writeVarint(bytes, deltaMicros);
+    bytes.push_back(static_cast<char>((isPressed ? FLAG_PRESSED : 0) | (mouse ? FLAG_MOUSE : 0)));
+    writeVarint(bytes, code);
+    // Left to the stream's buffer; the file is complete once the recorder is closed
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+// Replayer
+
+InputTraceReplayer::InputTraceReplayer()
+    : stopping(false), running(false) {
+}
+
+InputTraceReplayer::~InputTraceReplayer() {
+    stop();
+}
+
+bool InputTraceReplayer::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("[InputTrace] Failed to open trace: " + path);
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(TRACE_MAGIC) + 1 ||
+        !std::equal(std::begin(TRACE_MAGIC), std::end(TRACE_MAGIC), data.begin()) ||
+        data[sizeof(TRACE_MAGIC)] != TRACE_VERSION) {
+        LOG_ERROR("[InputTrace] Not an input trace (or unsupported version): " + path);
+        return false;
+    }
+
+    events.clear();
+    size_t offset = sizeof(TRACE_MAGIC) + 1;
+    while (offset < data.size()) {
+        InputTraceEvent event;
+        uint64_t code = 0;
+        if (!readVarint(data, offset, event.deltaMicros) || offset >= data.size()) {
+            break;
+        }
+        uint8_t flags = data[offset++];
+        if (!readVarint(data, offset, code)) {
+            break;
+        }
+        event.pressed = (flags & FLAG_PRESSED) != 0;
+        event.mouse = (flags & FLAG_MOUSE) != 0;
+        event.code = static_cast<unsigned int>(code);
+        events.push_back(event);
+    }
+    if (offset < data.size()) {
+        // A recording cut short (crash, kill) still replays up to the damage
+        LOG_WARNING("[InputTrace] Trace truncated after " + std::to_string(events.size()) + " events: " + path);
+    }
+
+    LOG_INFO("[InputTrace] Loaded " + std::to_string(events.size()) + " events from " + path);
+    return true;
+}
+
+void InputTraceReplayer::start(double speed, KeyCallback onKey, MouseCallback onMouse, std::function<void()> onFinished) {
+    stop();
+
+    stopping = false;
+    running = true;
+    replayThread = std::thread([this, speed, onKey, onMouse, onFinished]() {
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point startTime = Clock::now();
+        uint64_t traceMicros = 0;
+
+        for (const InputTraceEvent& event : events) {
+            traceMicros += event.deltaMicros;
+            if (speed > 0.0) {
+                // Schedule against the start so rounding and callback time don't accumulate
+                auto due = startTime + std::chrono::microseconds(static_cast<int64_t>(static_cast<double>(traceMicros) / speed));
+                std::unique_lock<std::mutex> lock(replayMutex);
+                if (stopCondition.wait_until(lock, due, [this]() { return stopping; })) {
+                    break;
+                }
+            } else {
+                std::lock_guard<std::mutex> lock(replayMutex);
+                if (stopping) {
+                    break;
+                }
+            }
+
+            if (event.mouse) {
+                if (onMouse) {
+                    onMouse(static_cast<int>(event.code), event.pressed);
+                }
+            } else if (onKey) {
+                onKey(event.code, event.pressed);
+            }
+        }
+
+        running = false;
+        if (onFinished) {
+            onFinished();
+        }
+    });
+}
+
+void InputTraceReplayer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(replayMutex);
+        stopping = true;
+    }
+    stopCondition.notify_all();
+    if (replayThread.joinable()) {
+        replayThread.join();
+    }
+    running = false;
+}
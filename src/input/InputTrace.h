@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compact binary trace of timestamped key and mouse button events, for reproducing a
+// typing session without a keyboard (benchmarks, bug reports).
+//
+// Format: "OBIT" magic, a version byte, then one record per event:
+//   varint  microseconds since the previous event
+//   byte    bit 0 pressed, bit 1 mouse button (otherwise key)
+//   varint  virtual key code or MouseHook::ButtonType
+// A typical key event takes 3-4 bytes.
+struct InputTraceEvent {
+    uint64_t deltaMicros = 0;
+    bool mouse = false;
+    bool pressed = false;
+    unsigned int code = 0;
+};
+
+// Appends events as they arrive. Thread-safe: the keyboard and mouse hooks may run on different threads.
+class InputTraceRecorder {
+public:
+    InputTraceRecorder();
+    ~InputTraceRecorder();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    void recordKey(unsigned int keyCode, bool isPressed);
+    void recordMouseButton(int button, bool isPressed);
+
+private:
+    mutable std::mutex recorderMutex;
+    std::ofstream file;
+    std::chrono::steady_clock::time_point lastEventTime;
+    bool firstEvent;
+
+    void record(bool mouse, unsigned int code, bool isPressed);
+};
+
+// Plays a recorded trace back on its own thread, through the same callbacks the hooks use.
+class InputTraceReplayer {
+public:
+    using KeyCallback = std::function<void(unsigned int keyCode, bool isPressed)>;
+    using MouseCallback = std::function<void(int button, bool isPressed)>;
+
+    InputTraceReplayer();
+    ~InputTraceReplayer();
+
+    bool load(const std::string& path);
+    size_t getEventCount() const { return events.size(); }
+
+    // speed scales the recorded timing (1 = real time, 4 = four times faster);
+    // 0 replays as fast as possible. onFinished is called from the replay thread.
+    void start(double speed, KeyCallback onKey, MouseCallback onMouse, std::function<void()> onFinished = nullptr);
+    void stop();
+    bool isRunning() const { return running; }
+
+private:
+    std::vector<InputTraceEvent> events;
+    std::thread replayThread;
+    std::mutex replayMutex;
+    std::condition_variable stopCondition;
+    bool stopping;
+    std::atomic<bool> running;
+};
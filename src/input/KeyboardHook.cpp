@@ -1,9 +1,12 @@
 #include "input/KeyboardHook.h"
+#include "input/InputTrace.h"
 
 #ifdef _WIN32
 #include "platform/WindowsKeyboardHook.h"
 #elif __APPLE__
 #include "platform/MacKeyboardHook.h"
+#elif __linux__
+#include "platform/LinuxInputHook.h"
 #endif
 
 KeyboardHook::KeyboardHook() 
@@ -19,37 +22,61 @@ bool KeyboardHook::initialize(KeyPressCallback callback) {
         return true;
     }
     
+    // Kept even if the platform hook fails so replayed input still reaches it
+    onKeyPress = callback;
+    
 #ifdef _WIN32
     platformData = new WindowsKeyboardHook();
     WindowsKeyboardHook* hook = static_cast<WindowsKeyboardHook*>(platformData);
     // Convert KeyboardHook callback to WindowsKeyboardHook callback
-    WindowsKeyboardHook::KeyPressCallback winCallback = [callback](DWORD vkCode, bool isPressed) {
-        callback(static_cast<unsigned int>(vkCode), isPressed);
+    WindowsKeyboardHook::KeyPressCallback winCallback = [this](DWORD vkCode, bool isPressed) {
+        handleKey(static_cast<unsigned int>(vkCode), isPressed);
     };
     initialized = hook->initialize(winCallback);
 #elif __APPLE__
     platformData = new MacKeyboardHook();
     MacKeyboardHook* hook = static_cast<MacKeyboardHook*>(platformData);
     // Mac keyboard hook still uses old callback signature
-    MacKeyboardHook::KeyPressCallback macCallback = [callback]() {
+    MacKeyboardHook::KeyPressCallback macCallback = [this]() {
         // For Mac, we don't have key code info in the old callback
         // Use a dummy key code (0) - this might need to be updated for Mac
-        callback(0, true);
+        handleKey(0, true);
     };
     initialized = hook->initialize(macCallback);
+#elif __linux__
+    // Shared evdev reader; it already reports Windows virtual key codes
+    initialized = LinuxInputHook::getInstance().setKeyboardCallback([this](unsigned int keyCode, bool isPressed) {
+        handleKey(keyCode, isPressed);
+    });
 #else
     return false;
 #endif
     
-    if (initialized) {
-        onKeyPress = callback;
-    }
-    
     return initialized;
 }
 
+void KeyboardHook::setRecorder(std::shared_ptr<InputTraceRecorder> newRecorder) {
+    std::atomic_store(&recorder, std::move(newRecorder));
+}
+
+void KeyboardHook::injectKey(unsigned int keyCode, bool isPressed) {
+    if (onKeyPress) {
+        onKeyPress(keyCode, isPressed);
+    }
+}
+
+void KeyboardHook::handleKey(unsigned int keyCode, bool isPressed) {
+    if (std::shared_ptr<InputTraceRecorder> activeRecorder = std::atomic_load(&recorder)) {
+        activeRecorder->recordKey(keyCode, isPressed);
+    }
+    if (onKeyPress) {
+        onKeyPress(keyCode, isPressed);
+    }
+}
+
 void KeyboardHook::shutdown() {
     if (!initialized) {
+        onKeyPress = nullptr;
         return;
     }
     
@@ -67,6 +94,8 @@ void KeyboardHook::shutdown() {
         delete hook;
         platformData = nullptr;
     }
+#elif __linux__
+    LinuxInputHook::getInstance().setKeyboardCallback(nullptr);
 #endif
     
     initialized = false;
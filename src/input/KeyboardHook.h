@@ -1,6 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+
+class InputTraceRecorder;
 
 class KeyboardHook {
 public:
@@ -14,9 +17,19 @@ public:
     
     bool isInitialized() const { return initialized; }
     
+    // Write every hook event to recorder (nullptr stops recording)
+    void setRecorder(std::shared_ptr<InputTraceRecorder> recorder);
+    
+    // Deliver a key event to the callback as if the platform hook had seen it (trace replay).
+    // Works once initialize() has been called, even if the platform hook failed.
+    void injectKey(unsigned int keyCode, bool isPressed);
+    
 private:
     bool initialized;
     KeyPressCallback onKeyPress;
+    std::shared_ptr<InputTraceRecorder> recorder; // Accessed with std::atomic_load/store (hook thread)
+    
+    void handleKey(unsigned int keyCode, bool isPressed);
     
     // Platform-specific implementation
     void* platformData;
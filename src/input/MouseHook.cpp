@@ -1,9 +1,12 @@
 #include "input/MouseHook.h"
+#include "input/InputTrace.h"
 
 #ifdef _WIN32
 #include "platform/WindowsMouseHook.h"
 #elif __APPLE__
 // TODO: Add Mac mouse hook if needed
+#elif __linux__
+#include "platform/LinuxInputHook.h"
 #endif
 
 MouseHook::MouseHook() 
@@ -19,32 +22,57 @@ bool MouseHook::initialize(MouseClickCallback callback) {
         return true;
     }
     
+    // Kept even if the platform hook fails so replayed input still reaches it
+    onMouseClick = callback;
+    
 #ifdef _WIN32
     platformData = new WindowsMouseHook();
     WindowsMouseHook* hook = static_cast<WindowsMouseHook*>(platformData);
     // Convert MouseHook callback to WindowsMouseHook callback
-    WindowsMouseHook::MouseClickCallback winCallback = [callback](WindowsMouseHook::ButtonType button, bool isPressed) {
+    WindowsMouseHook::MouseClickCallback winCallback = [this](WindowsMouseHook::ButtonType button, bool isPressed) {
         // Convert WindowsMouseHook::ButtonType to MouseHook::ButtonType
         MouseHook::ButtonType hookButton = static_cast<MouseHook::ButtonType>(button);
-        callback(hookButton, isPressed);
+        handleButton(hookButton, isPressed);
     };
     initialized = hook->initialize(winCallback);
 #elif __APPLE__
     // TODO: Add Mac mouse hook implementation
     return false;
+#elif __linux__
+    // Shared evdev reader (same thread as the keyboard)
+    LinuxInputHook::MouseClickCallback linuxCallback = [this](LinuxInputHook::ButtonType button, bool isPressed) {
+        handleButton(static_cast<MouseHook::ButtonType>(button), isPressed);
+    };
+    initialized = LinuxInputHook::getInstance().setMouseCallback(linuxCallback);
 #else
     return false;
 #endif
     
-    if (initialized) {
-        onMouseClick = callback;
-    }
-    
     return initialized;
 }
 
+void MouseHook::setRecorder(std::shared_ptr<InputTraceRecorder> newRecorder) {
+    std::atomic_store(&recorder, std::move(newRecorder));
+}
+
+void MouseHook::injectButton(ButtonType button, bool isPressed) {
+    if (onMouseClick) {
+        onMouseClick(button, isPressed);
+    }
+}
+
+void MouseHook::handleButton(ButtonType button, bool isPressed) {
+    if (std::shared_ptr<InputTraceRecorder> activeRecorder = std::atomic_load(&recorder)) {
+        activeRecorder->recordMouseButton(static_cast<int>(button), isPressed);
+    }
+    if (onMouseClick) {
+        onMouseClick(button, isPressed);
+    }
+}
+
 void MouseHook::shutdown() {
     if (!initialized) {
+        onMouseClick = nullptr;
         return;
     }
     
@@ -57,6 +85,8 @@ void MouseHook::shutdown() {
     }
 #elif __APPLE__
     // TODO: Add Mac mouse hook cleanup
+#elif __linux__
+    LinuxInputHook::getInstance().setMouseCallback(nullptr);
 #endif
     
     initialized = false;
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+
+class InputTraceRecorder;
 
 class MouseHook {
 public:
@@ -20,9 +23,19 @@ public:
     
     bool isInitialized() const { return initialized; }
     
+    // Write every hook event to recorder (nullptr stops recording)
+    void setRecorder(std::shared_ptr<InputTraceRecorder> recorder);
+    
+    // Deliver a button event to the callback as if the platform hook had seen it (trace replay).
+    // Works once initialize() has been called, even if the platform hook failed.
+    void injectButton(ButtonType button, bool isPressed);
+    
 private:
     bool initialized;
     MouseClickCallback onMouseClick;
+    std::shared_ptr<InputTraceRecorder> recorder; // Accessed with std::atomic_load/store (hook thread)
+    
+    void handleButton(ButtonType button, bool isPressed);
     
     // Platform-specific implementation
     void* platformData;
@@ -0,0 +1,80 @@
+#include "managers/CatPackLoader.h"
+#include "utils/Logger.h"
+
+CatPackLoader::CatPackLoader(std::function<void()> onReady)
+    : onReadyCallback(std::move(onReady)), stopping(false) {
+    worker = std::thread(&CatPackLoader::workerLoop, this);
+}
+
+CatPackLoader::~CatPackLoader() {
+    {
+        std::lock_guard<std::mutex> lock(loaderMutex);
+        stopping = true;
+    }
+    requestCondition.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void CatPackLoader::request(const CatPackConfig& config) {
+    {
+        std::lock_guard<std::mutex> lock(loaderMutex);
+        pendingRequest = config;
+    }
+    requestCondition.notify_one();
+}
+
+std::optional<CatPackLoader::LoadedPack> CatPackLoader::takeReady() {
+    std::lock_guard<std::mutex> lock(loaderMutex);
+    std::optional<LoadedPack> pack = std::move(readyPack);
+    readyPack.reset();
+    return pack;
+}
+
+void CatPackLoader::workerLoop() {
+    while (true) {
+        CatPackConfig config;
+        {
+            std::unique_lock<std::mutex> lock(loaderMutex);
+            requestCondition.wait(lock, [this]() { return stopping || pendingRequest.has_value(); });
+            if (stopping) {
+                return;
+            }
+            config = std::move(*pendingRequest);
+            pendingRequest.reset();
+        }
+        
+        LoadedPack pack;
+        pack.config = config;
+        pack.decoded = false;
+        try {
+            if (!config.folderPath.empty() && !config.bodyImage.empty()) {
+                TextureCache& cache = TextureCache::getInstance();
+                pack.decoded = cache.decode(config.getImagePath(config.bodyImage), pack.images[0]) &&
+                               cache.decode(config.getImagePath(config.handUpImage), pack.images[1]) &&
+                               cache.decode(config.getImagePath(config.handDownImage), pack.images[2]);
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("[CatPackLoader] Exception decoding cat pack " + config.name + ": " + std::string(e.what()));
+            pack.decoded = false;
+        }
+        
+        if (!pack.decoded) {
+            LOG_WARNING("[CatPackLoader] Could not decode cat pack " + config.name + " in the background");
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(loaderMutex);
+            // A newer request makes this result stale - drop it and load that one instead
+            if (pendingRequest.has_value()) {
+                continue;
+            }
+            readyPack = std::move(pack);
+        }
+        
+        if (onReadyCallback) {
+            onReadyCallback();
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "config/CatPackConfig.h"
+#include "managers/TextureCache.h"
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+// Decodes cat pack images on a background thread so switching packs never stalls a frame.
+// request() can be called from any thread (the settings UI handler runs on server threads);
+// the render thread picks up the finished pack with takeReady() at a frame boundary and
+// uploads it there, so the previous pack keeps rendering until the new one is complete.
+class CatPackLoader {
+public:
+    // Decoded pack waiting to be uploaded on the render thread
+    struct LoadedPack {
+        CatPackConfig config;
+        std::array<TextureCache::DecodedImage, 3> images; // Body, hand up, hand down
+        bool decoded = false; // False if an image failed; the caller loads synchronously (with fallbacks)
+    };
+    
+    // onReady is called from the worker thread when a pack finishes decoding
+    explicit CatPackLoader(std::function<void()> onReady);
+    ~CatPackLoader();
+    
+    // Start loading config; supersedes any request that hasn't finished yet
+    void request(const CatPackConfig& config);
+    
+    // Render thread: take the most recently finished pack, if any
+    std::optional<LoadedPack> takeReady();
+    
+private:
+    std::function<void()> onReadyCallback;
+    
+    std::mutex loaderMutex;
+    std::condition_variable requestCondition;
+    std::optional<CatPackConfig> pendingRequest;
+    std::optional<LoadedPack> readyPack;
+    bool stopping;
+    
+    std::thread worker;
+    
+    void workerLoop();
+};
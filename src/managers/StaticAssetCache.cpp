@@ -0,0 +1,222 @@
+#include "managers/StaticAssetCache.h"
+#include "utils/Hash.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <system_error>
+
+#ifdef OPENBONGO_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+    // Larger files are served but not kept (nothing the UI ships comes close)
+    constexpr std::uintmax_t MAX_CACHED_FILE_BYTES = 8 * 1024 * 1024;
+    
+    // Below this the gzip header and the extra header lines outweigh the savings
+    constexpr size_t MIN_COMPRESSED_FILE_BYTES = 1024;
+}
+
+StaticAssetCache::StaticAssetCache()
+    : usedBytes(0) {
+}
+
+std::shared_ptr<const StaticAssetCache::Asset> StaticAssetCache::get(const std::filesystem::path& path) {
+    std::error_code ec;
+    std::uintmax_t fileSize = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return nullptr;
+    }
+    std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return nullptr;
+    }
+    
+    const std::string key = path.string();
+    {
+        // Unchanged since it was read: no disk I/O beyond the stat
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = assets.find(key);
+        if (it != assets.end() && it->second->size == fileSize && it->second->writeTime == writeTime) {
+            return it->second;
+        }
+    }
+    
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+    auto asset = std::make_shared<Asset>();
+    asset->body.resize(static_cast<size_t>(fileSize));
+    if (!asset->body.empty() && !file.read(&asset->body[0], static_cast<std::streamsize>(asset->body.size()))) {
+        LOG_WARNING("[StaticAssetCache] Failed to read " + key);
+        return nullptr;
+    }
+    asset->contentType = getContentType(path);
+    asset->size = fileSize;
+    asset->writeTime = writeTime;
+    
+    char etag[24];
+    std::snprintf(etag, sizeof(etag), "\"%016llx\"", static_cast<unsigned long long>(Hash::fnv1a(asset->body.data(), asset->body.size())));
+    asset->etag = etag;
+    
+    // Compressed once here; the body is kept only if it actually came out smaller
+    if (isCompressible(asset->contentType) && asset->body.size() >= MIN_COMPRESSED_FILE_BYTES &&
+        gzip(asset->body, asset->gzipBody) && asset->gzipBody.size() < asset->body.size()) {
+        asset->gzipETag = asset->etag.substr(0, asset->etag.size() - 1) + "-gz\"";
+    } else {
+        asset->gzipBody.clear();
+    }
+    
+    if (fileSize > MAX_CACHED_FILE_BYTES) {
+        return asset;
+    }
+    
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = assets.find(key);
+    if (it != assets.end()) {
+        usedBytes -= it->second->body.size() + it->second->gzipBody.size();
+        it->second = asset;
+    } else {
+        assets.emplace(key, asset);
+    }
+    usedBytes += asset->body.size() + asset->gzipBody.size();
+    return asset;
+}
+
+std::string StaticAssetCache::makeFileETag(std::uintmax_t size, std::filesystem::file_time_type writeTime) {
+    char etag[48];
+    std::snprintf(etag, sizeof(etag), "\"%llx-%llx\"", static_cast<unsigned long long>(size),
+                  static_cast<unsigned long long>(writeTime.time_since_epoch().count()));
+    return etag;
+}
+
+bool StaticAssetCache::matchesETag(const std::string& ifNoneMatch, const std::string& etag) {
+    // Comma separated list of tags, optionally weak (W/"..."); weak comparison is what If-None-Match uses
+    size_t pos = 0;
+    while (pos < ifNoneMatch.size()) {
+        size_t end = ifNoneMatch.find(',', pos);
+        if (end == std::string::npos) {
+            end = ifNoneMatch.size();
+        }
+        size_t first = ifNoneMatch.find_first_not_of(" \t", pos);
+        size_t last = ifNoneMatch.find_last_not_of(" \t", end - 1);
+        if (first != std::string::npos && first < end && last >= first) {
+            std::string tag = ifNoneMatch.substr(first, last - first + 1);
+            if (tag == "*") {
+                return true;
+            }
+            if (tag.compare(0, 2, "W/") == 0) {
+                tag.erase(0, 2);
+            }
+            if (tag == etag) {
+                return true;
+            }
+        }
+        pos = end + 1;
+    }
+    return false;
+}
+
+bool StaticAssetCache::acceptsGzip(const std::string& acceptEncoding) {
+    // Comma separated codings with optional weights; "gzip;q=0" explicitly refuses it
+    std::optional<bool> gzipCoding;
+    std::optional<bool> anyCoding;
+    size_t pos = 0;
+    while (pos < acceptEncoding.size()) {
+        size_t end = acceptEncoding.find(',', pos);
+        if (end == std::string::npos) {
+            end = acceptEncoding.size();
+        }
+        std::string coding = acceptEncoding.substr(pos, end - pos);
+        std::string params;
+        size_t semicolon = coding.find(';');
+        if (semicolon != std::string::npos) {
+            params = coding.substr(semicolon + 1);
+            coding.erase(semicolon);
+        }
+        coding.erase(std::remove_if(coding.begin(), coding.end(), [](unsigned char c) { return std::isspace(c) != 0; }), coding.end());
+        std::transform(coding.begin(), coding.end(), coding.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (coding == "gzip" || coding == "x-gzip" || coding == "*") {
+            params.erase(std::remove_if(params.begin(), params.end(), [](unsigned char c) { return std::isspace(c) != 0; }), params.end());
+            bool accepted = params.compare(0, 2, "q=") != 0 || std::atof(params.c_str() + 2) > 0.0;
+            if (coding == "*") {
+                anyCoding = accepted;
+            } else {
+                gzipCoding = accepted;
+            }
+        }
+        pos = end + 1;
+    }
+    // An explicit gzip entry wins over "*" wherever it appears ("*;q=1, gzip;q=0" refuses gzip)
+    if (gzipCoding) {
+        return *gzipCoding;
+    }
+    return anyCoding.value_or(false);
+}
+
+std::string StaticAssetCache::getContentType(const std::filesystem::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (ext == ".html" || ext == ".htm") {
+        return "text/html; charset=utf-8";
+    } else if (ext == ".css") {
+        return "text/css";
+    } else if (ext == ".js") {
+        return "application/javascript";
+    } else if (ext == ".png") {
+        return "image/png";
+    } else if (ext == ".jpg" || ext == ".jpeg") {
+        return "image/jpeg";
+    } else if (ext == ".gif") {
+        return "image/gif";
+    }
+    return "application/octet-stream";
+}
+
+size_t StaticAssetCache::getUsage() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return usedBytes;
+}
+
+void StaticAssetCache::clear() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    assets.clear();
+    usedBytes = 0;
+}
+
+bool StaticAssetCache::isCompressible(const std::string& contentType) {
+    // Images are already compressed
+    return contentType.compare(0, 5, "text/") == 0 || contentType == "application/javascript";
+}
+
+bool StaticAssetCache::gzip(const std::string& data, std::string& compressed) {
+#ifdef OPENBONGO_HAVE_ZLIB
+    z_stream stream{};
+    // 15 window bits + 16 selects the gzip wrapper; best compression since it runs once per file version
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    compressed.resize(deflateBound(&stream, static_cast<uLong>(data.size())));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+    stream.avail_out = static_cast<uInt>(compressed.size());
+    int result = deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        compressed.clear();
+        return false;
+    }
+    return true;
+#else
+    (void)data;
+    compressed.clear();
+    return false;
+#endif
+}
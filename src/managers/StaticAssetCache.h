@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// In-memory cache of the settings UI's own files (HTML, CSS, JS). Pack and hat images are
+// streamed from disk instead (see makeFileETag) so they never sit in the heap.
+// Entries are keyed by path and revalidated with a stat on every lookup: an unchanged size and
+// modification time serves the cached bytes, anything else reads the file again. Each asset
+// carries a strong ETag (content hash) so the server can answer If-None-Match with 304.
+// Text assets are also gzipped once when read (if built with zlib), so every later request
+// for them sends the precompressed body.
+// Lives for the whole run, so reopening the settings window is served from memory.
+class StaticAssetCache {
+public:
+    static StaticAssetCache& getInstance() {
+        static StaticAssetCache instance;
+        return instance;
+    }
+    
+    struct Asset {
+        std::string body;
+        std::string contentType;
+        std::string etag; // Quoted, ready for the ETag header
+        std::string gzipBody; // Empty when not compressed (binary, tiny, or no zlib)
+        std::string gzipETag; // Distinct tag for the gzip representation
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type writeTime;
+    };
+    
+    // Cached asset for path, re-read if it changed on disk. Returns nullptr if it can't be read.
+    // The returned asset stays valid even if the entry is replaced meanwhile.
+    std::shared_ptr<const Asset> get(const std::filesystem::path& path);
+    
+    // Strong ETag for a file served straight from disk, from its size and modification time
+    static std::string makeFileETag(std::uintmax_t size, std::filesystem::file_time_type writeTime);
+    
+    // True if an If-None-Match header value names etag (or is "*")
+    static bool matchesETag(const std::string& ifNoneMatch, const std::string& etag);
+    
+    // True if an Accept-Encoding header value allows gzip
+    static bool acceptsGzip(const std::string& acceptEncoding);
+    
+    static std::string getContentType(const std::filesystem::path& path);
+    
+    size_t getUsage() const; // Bytes of cached bodies
+    void clear();
+    
+private:
+    StaticAssetCache();
+    StaticAssetCache(const StaticAssetCache&) = delete;
+    StaticAssetCache& operator=(const StaticAssetCache&) = delete;
+    
+    std::unordered_map<std::string, std::shared_ptr<const Asset>> assets; // By path
+    size_t usedBytes;
+    mutable std::mutex cacheMutex;
+    
+    static bool isCompressible(const std::string& contentType);
+    static bool gzip(const std::string& data, std::string& compressed);
+};
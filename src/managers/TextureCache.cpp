@@ -0,0 +1,373 @@
+#include "managers/TextureCache.h"
+#include "utils/Hash.h"
+#include "utils/ImageHelper.h"
+#include "utils/Logger.h"
+#include <iomanip>
+#include <sstream>
+#include <fstream>
+#include <vector>
+
+namespace {
+    // Room for a few full packs and hats at typical image sizes
+    constexpr size_t DEFAULT_BUDGET_BYTES = 96 * 1024 * 1024;
+}
+
+TextureCache::TextureCache()
+    : budgetBytes(DEFAULT_BUDGET_BYTES), usedBytes(0), scaleStopping(false) {
+}
+
+TextureCache::~TextureCache() {
+    {
+        std::lock_guard<std::mutex> lock(scaleMutex);
+        scaleStopping = true;
+    }
+    scaleCondition.notify_one();
+    if (scaleWorker.joinable()) {
+        scaleWorker.join();
+    }
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::load(const std::string& path) {
+    std::uintmax_t fileSize = 0;
+    std::filesystem::file_time_type writeTime;
+    if (!statFile(path, fileSize, writeTime)) {
+        return nullptr;
+    }
+    
+    // Unchanged file whose texture is still cached: no disk read at all
+    if (auto cached = findCached(path, fileSize, writeTime)) {
+        return cached;
+    }
+    
+    std::vector<char> data;
+    if (!readFile(path, fileSize, data)) {
+        return nullptr;
+    }
+    FileStamp stamp{fileSize, writeTime, Hash::fnv1a(data.data(), data.size())};
+    
+    {
+        // Same image already loaded from another path (e.g. a pack reusing the default art)
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        files[path] = stamp;
+        auto textureIt = textures.find(stamp.contentHash);
+        if (textureIt != textures.end()) {
+            return use(textureIt->second);
+        }
+    }
+    
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromMemory(data.data(), data.size())) {
+        LOG_WARNING("[TextureCache] Failed to decode image: " + path);
+        return nullptr;
+    }
+    return insert(stamp.contentHash, std::move(texture));
+}
+
+bool TextureCache::decode(const std::string& path, DecodedImage& decoded) {
+    decoded.path = path;
+    decoded.alreadyCached = false;
+    if (!statFile(path, decoded.size, decoded.writeTime)) {
+        return false;
+    }
+    
+    if (findCached(path, decoded.size, decoded.writeTime)) {
+        decoded.alreadyCached = true;
+        return true;
+    }
+    
+    std::vector<char> data;
+    if (!readFile(path, decoded.size, data)) {
+        return false;
+    }
+    decoded.contentHash = Hash::fnv1a(data.data(), data.size());
+    
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        if (textures.count(decoded.contentHash) > 0) {
+            files[path] = FileStamp{decoded.size, decoded.writeTime, decoded.contentHash};
+            decoded.alreadyCached = true;
+            return true;
+        }
+    }
+    
+    if (!decoded.image.loadFromMemory(data.data(), data.size())) {
+        LOG_WARNING("[TextureCache] Failed to decode image: " + path);
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::upload(const DecodedImage& decoded) {
+    if (decoded.alreadyCached) {
+        // Normally a hit; if the texture was evicted since decoding, this loads it synchronously
+        return load(decoded.path);
+    }
+    
+    auto texture = std::make_shared<sf::Texture>();
+    if (!texture->loadFromImage(decoded.image)) {
+        LOG_WARNING("[TextureCache] Failed to upload image: " + decoded.path);
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        files[decoded.path] = FileStamp{decoded.size, decoded.writeTime, decoded.contentHash};
+    }
+    return insert(decoded.contentHash, std::move(texture));
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::findScaled(const std::string& path, sf::Vector2u targetSize) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    
+    // The original's content hash names the scaled versions; its texture gives the size
+    auto fileIt = files.find(path);
+    if (fileIt == files.end()) {
+        return nullptr;
+    }
+    std::uint64_t contentHash = fileIt->second.contentHash;
+    auto originalIt = textures.find(contentHash);
+    if (originalIt == textures.end()) {
+        return nullptr;
+    }
+    sf::Vector2u originalSize = originalIt->second.texture->getSize();
+    if (targetSize.x == 0 || targetSize.y == 0 || targetSize.x > originalSize.x || targetSize.y > originalSize.y ||
+        targetSize == originalSize) {
+        return nullptr;
+    }
+    
+    // Scaled versions live in the same LRU under a key derived from content and size
+    std::uint64_t key = contentHash;
+    for (unsigned int dimension : {targetSize.x, targetSize.y}) {
+        key ^= dimension;
+        key *= Hash::FNV_PRIME;
+    }
+    auto textureIt = textures.find(key);
+    if (textureIt != textures.end()) {
+        return use(textureIt->second);
+    }
+    
+    ScaleJob job;
+    job.path = path;
+    job.contentHash = contentHash;
+    job.key = key;
+    job.targetSize = targetSize;
+    if (!diskCacheDirectory.empty()) {
+        std::ostringstream name;
+        name << std::hex << std::setw(16) << std::setfill('0') << contentHash << std::dec
+             << "_" << targetSize.x << "x" << targetSize.y << ".png";
+        job.diskPath = (std::filesystem::path(diskCacheDirectory) / name.str()).string();
+    }
+    
+    {
+        std::lock_guard<std::mutex> scaleLock(scaleMutex);
+        if (!scaleRequested.insert(key).second) {
+            return nullptr;
+        }
+        scaleQueue.push_back(std::move(job));
+        if (!scaleWorker.joinable()) {
+            scaleWorker = std::thread(&TextureCache::scaleWorkerLoop, this);
+        }
+    }
+    scaleCondition.notify_one();
+    return nullptr;
+}
+
+bool TextureCache::uploadScaled() {
+    std::vector<ScaleJob> finished;
+    {
+        std::lock_guard<std::mutex> lock(scaleMutex);
+        finished.swap(scaledReady);
+    }
+    
+    bool added = false;
+    for (const ScaleJob& job : finished) {
+        auto texture = std::make_shared<sf::Texture>();
+        if (!texture->loadFromImage(job.image)) {
+            LOG_WARNING("[TextureCache] Failed to upload scaled image: " + job.path);
+            continue;
+        }
+        insert(job.key, std::move(texture));
+        added = true;
+    }
+    return added;
+}
+
+void TextureCache::setScaledReadyCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(scaleMutex);
+    onScaledReady = std::move(callback);
+}
+
+void TextureCache::scaleWorkerLoop() {
+    while (true) {
+        ScaleJob job;
+        {
+            std::unique_lock<std::mutex> lock(scaleMutex);
+            scaleCondition.wait(lock, [this]() { return scaleStopping || !scaleQueue.empty(); });
+            if (scaleStopping) {
+                return;
+            }
+            job = std::move(scaleQueue.front());
+            scaleQueue.erase(scaleQueue.begin());
+        }
+        
+        bool made = false;
+        try {
+            made = makeScaled(job);
+        } catch (const std::exception& e) {
+            LOG_ERROR("[TextureCache] Exception scaling " + job.path + ": " + std::string(e.what()));
+        }
+        
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(scaleMutex);
+            if (!made) {
+                // Left in scaleRequested: the original keeps being drawn rather than retrying every reload
+                continue;
+            }
+            scaledReady.push_back(std::move(job));
+            callback = onScaledReady;
+        }
+        if (callback) {
+            callback();
+        }
+    }
+}
+
+bool TextureCache::makeScaled(ScaleJob& job) {
+    std::error_code ec;
+    if (!job.diskPath.empty() && std::filesystem::exists(job.diskPath, ec) &&
+        job.image.loadFromFile(job.diskPath) && job.image.getSize() == job.targetSize) {
+        return true;
+    }
+    
+    std::uintmax_t fileSize = 0;
+    std::filesystem::file_time_type writeTime;
+    std::vector<char> data;
+    sf::Image source;
+    if (!statFile(job.path, fileSize, writeTime) || !readFile(job.path, fileSize, data)) {
+        return false;
+    }
+    if (Hash::fnv1a(data.data(), data.size()) != job.contentHash) {
+        return false; // Changed since it was loaded; the next load requests the new content
+    }
+    if (!source.loadFromMemory(data.data(), data.size())) {
+        LOG_WARNING("[TextureCache] Failed to decode image for scaling: " + job.path);
+        return false;
+    }
+    job.image = ImageHelper::resizeArea(source, job.targetSize);
+    
+    if (!job.diskPath.empty()) {
+        std::filesystem::create_directories(std::filesystem::path(job.diskPath).parent_path(), ec);
+        if (!job.image.saveToFile(job.diskPath)) {
+            LOG_WARNING("[TextureCache] Failed to write scaled image: " + job.diskPath);
+        }
+    }
+    return true;
+}
+
+void TextureCache::setDiskCacheDirectory(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    diskCacheDirectory = directory;
+}
+
+void TextureCache::setBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    budgetBytes = bytes;
+    if (usedBytes > budgetBytes) {
+        evict(budgetBytes);
+    }
+}
+
+size_t TextureCache::getBudget() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return budgetBytes;
+}
+
+size_t TextureCache::getUsage() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return usedBytes;
+}
+
+void TextureCache::trim() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    evict(0);
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::use(Entry& entry) {
+    lru.splice(lru.begin(), lru, entry.lruPosition);
+    return entry.texture;
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::findCached(const std::string& path, std::uintmax_t size,
+                                                            std::filesystem::file_time_type writeTime) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto fileIt = files.find(path);
+    if (fileIt == files.end() || fileIt->second.size != size || fileIt->second.writeTime != writeTime) {
+        return nullptr;
+    }
+    auto textureIt = textures.find(fileIt->second.contentHash);
+    if (textureIt == textures.end()) {
+        return nullptr;
+    }
+    return use(textureIt->second);
+}
+
+std::shared_ptr<const sf::Texture> TextureCache::insert(std::uint64_t key, std::shared_ptr<sf::Texture> texture) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    
+    // Another load of the same content may have finished first
+    auto textureIt = textures.find(key);
+    if (textureIt != textures.end()) {
+        return use(textureIt->second);
+    }
+    
+    sf::Vector2u textureSize = texture->getSize();
+    size_t bytes = static_cast<size_t>(textureSize.x) * textureSize.y * 4;
+    
+    lru.push_front(key);
+    textures[key] = Entry{texture, bytes, lru.begin()};
+    usedBytes += bytes;
+    
+    if (usedBytes > budgetBytes) {
+        evict(budgetBytes);
+    }
+    
+    return texture;
+}
+
+void TextureCache::evict(size_t targetBytes) {
+    // Walk from least recently used; textures still held by a sprite can't be freed
+    auto it = lru.end();
+    while (usedBytes > targetBytes && it != lru.begin()) {
+        --it;
+        auto textureIt = textures.find(*it);
+        if (textureIt == textures.end() || textureIt->second.texture.use_count() > 1) {
+            continue;
+        }
+        
+        usedBytes -= textureIt->second.bytes;
+        textures.erase(textureIt);
+        it = lru.erase(it);
+    }
+    
+    // File stamps pointing at evicted textures are kept: they're tiny, and a later
+    // load still has to re-read the file to find out whether the content changed
+}
+
+bool TextureCache::statFile(const std::string& path, std::uintmax_t& size, std::filesystem::file_time_type& writeTime) {
+    std::error_code ec;
+    size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    writeTime = std::filesystem::last_write_time(path, ec);
+    return !ec;
+}
+
+bool TextureCache::readFile(const std::string& path, std::uintmax_t size, std::vector<char>& data) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(size));
+    return data.empty() || static_cast<bool>(file.read(data.data(), static_cast<std::streamsize>(data.size())));
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Shared cache of decoded textures for cat packs and hats.
+// Entries are keyed by image path and content hash: a path whose size and modification
+// time haven't changed is served without touching the file, and identical images in
+// different packs share one texture. Textures nobody holds are evicted least recently
+// used first once the cache exceeds its memory budget.
+class TextureCache {
+public:
+    static TextureCache& getInstance() {
+        static TextureCache instance;
+        return instance;
+    }
+    
+    // Image read and decoded off the render thread, waiting to be uploaded
+    struct DecodedImage {
+        std::string path;
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type writeTime;
+        std::uint64_t contentHash = 0;
+        sf::Image image;
+        bool alreadyCached = false; // Texture for this content is cached; image left empty
+    };
+    
+    // Load a texture through the cache. Returns nullptr if the file can't be read or decoded.
+    std::shared_ptr<const sf::Texture> load(const std::string& path);
+    
+    // Read and decode path into an image without touching the GPU (safe on any thread).
+    // Skips the read entirely if the file's texture is already cached. Returns false on failure.
+    bool decode(const std::string& path, DecodedImage& decoded);
+    
+    // Upload a decoded image (render thread) and return its texture
+    std::shared_ptr<const sf::Texture> upload(const DecodedImage& decoded);
+    
+    // Texture of path (loaded through the cache first) downscaled to exactly targetSize with an
+    // area filter, or nullptr if it isn't ready. On a miss the scaled image is made on a background
+    // thread - read from the disk cache directory, or resized from the original and saved there -
+    // and handed to uploadScaled(); meanwhile the caller keeps drawing the original.
+    // Also nullptr, with nothing queued, if targetSize isn't smaller than the image.
+    std::shared_ptr<const sf::Texture> findScaled(const std::string& path, sf::Vector2u targetSize);
+    
+    // Render thread: upload the scaled images finished since the last call.
+    // Returns true if any were added (callers then look them up again).
+    bool uploadScaled();
+    
+    // Called from the background thread when a scaled image is ready to upload
+    void setScaledReadyCallback(std::function<void()> callback);
+    
+    // Where scaled images are stored between runs (empty disables the disk cache)
+    void setDiskCacheDirectory(const std::string& directory);
+    
+    // Budget in bytes of decoded texture memory (width * height * 4 per texture)
+    void setBudget(size_t bytes);
+    size_t getBudget() const;
+    size_t getUsage() const;
+    
+    // Drop every texture not currently in use
+    void trim();
+    
+private:
+    TextureCache();
+    ~TextureCache();
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+    
+    struct FileStamp {
+        std::uintmax_t size;
+        std::filesystem::file_time_type writeTime;
+        std::uint64_t contentHash;
+    };
+    
+    struct Entry {
+        std::shared_ptr<sf::Texture> texture;
+        size_t bytes;
+        std::list<std::uint64_t>::iterator lruPosition;
+    };
+    
+    std::map<std::string, FileStamp> files;              // Path -> stamp seen when it was last read
+    std::unordered_map<std::uint64_t, Entry> textures;   // Content hash -> texture
+    std::list<std::uint64_t> lru;                        // Most recently used first
+    size_t budgetBytes;
+    size_t usedBytes;
+    std::string diskCacheDirectory;
+    
+    mutable std::mutex cacheMutex;
+    
+    // Scaled images are made one at a time on scaleWorker
+    struct ScaleJob {
+        std::string path;
+        std::uint64_t contentHash;
+        std::uint64_t key;
+        sf::Vector2u targetSize;
+        std::string diskPath;
+        sf::Image image; // Filled in by the worker
+    };
+    std::mutex scaleMutex;
+    std::condition_variable scaleCondition;
+    std::vector<ScaleJob> scaleQueue;
+    std::vector<ScaleJob> scaledReady;
+    std::set<std::uint64_t> scaleRequested; // Queued, ready or failed: never requested twice
+    std::function<void()> onScaledReady;
+    bool scaleStopping;
+    std::thread scaleWorker;
+    
+    void scaleWorkerLoop();
+    static bool makeScaled(ScaleJob& job);
+    
+    std::shared_ptr<const sf::Texture> use(Entry& entry);
+    std::shared_ptr<const sf::Texture> findCached(const std::string& path, std::uintmax_t size,
+                                                  std::filesystem::file_time_type writeTime);
+    std::shared_ptr<const sf::Texture> insert(std::uint64_t key, std::shared_ptr<sf::Texture> texture);
+    static bool statFile(const std::string& path, std::uintmax_t& size, std::filesystem::file_time_type& writeTime);
+    static bool readFile(const std::string& path, std::uintmax_t size, std::vector<char>& data);
+    void evict(size_t targetBytes);
+};
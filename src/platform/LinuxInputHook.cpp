@@ -0,0 +1,451 @@
+#ifdef __linux__
+
+#include "LinuxInputHook.h"
+#include "platform/VirtualKeyCodes.h"
+#include "utils/Logger.h"
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+using namespace VirtualKey;
+
+namespace {
+    const char* INPUT_DIRECTORY = "/dev/input";
+
+    // Events drained per read() - a key press is 3-6 events, so this covers a burst of typing
+    constexpr size_t EVENTS_PER_READ = 64;
+    constexpr int MAX_EPOLL_EVENTS = 16;
+
+    constexpr size_t bitsToLongs(size_t bits) {
+        return (bits + sizeof(unsigned long) * CHAR_BIT - 1) / (sizeof(unsigned long) * CHAR_BIT);
+    }
+
+    bool testBit(const unsigned long* bits, size_t bit) {
+        const size_t longBits = sizeof(unsigned long) * CHAR_BIT;
+        return (bits[bit / longBits] >> (bit % longBits)) & 1UL;
+    }
+
+    bool isEventDevice(const std::string& name) {
+        return name.compare(0, 5, "event") == 0;
+    }
+
+    // evdev key code to the Windows virtual key code BongoStats::getKeyName expects, 0 if unmapped
+    unsigned int toVirtualKey(uint16_t code) {
+        switch (code) {
+            case KEY_A: return 'A';
+            case KEY_B: return 'B';
+            case KEY_C: return 'C';
+            case KEY_D: return 'D';
+            case KEY_E: return 'E';
+            case KEY_F: return 'F';
+            case KEY_G: return 'G';
+            case KEY_H: return 'H';
+            case KEY_I: return 'I';
+            case KEY_J: return 'J';
+            case KEY_K: return 'K';
+            case KEY_L: return 'L';
+            case KEY_M: return 'M';
+            case KEY_N: return 'N';
+            case KEY_O: return 'O';
+            case KEY_P: return 'P';
+            case KEY_Q: return 'Q';
+            case KEY_R: return 'R';
+            case KEY_S: return 'S';
+            case KEY_T: return 'T';
+            case KEY_U: return 'U';
+            case KEY_V: return 'V';
+            case KEY_W: return 'W';
+            case KEY_X: return 'X';
+            case KEY_Y: return 'Y';
+            case KEY_Z: return 'Z';
+            case KEY_0: return '0';
+            case KEY_1: return '1';
+            case KEY_2: return '2';
+            case KEY_3: return '3';
+            case KEY_4: return '4';
+            case KEY_5: return '5';
+            case KEY_6: return '6';
+            case KEY_7: return '7';
+            case KEY_8: return '8';
+            case KEY_9: return '9';
+            case KEY_SPACE: return VK_SPACE;
+            case KEY_ENTER: return VK_RETURN;
+            case KEY_TAB: return VK_TAB;
+            case KEY_ESC: return VK_ESCAPE;
+            case KEY_BACKSPACE: return VK_BACK;
+            case KEY_DELETE: return VK_DELETE;
+            case KEY_INSERT: return VK_INSERT;
+            case KEY_HOME: return VK_HOME;
+            case KEY_END: return VK_END;
+            case KEY_PAGEUP: return VK_PRIOR;
+            case KEY_PAGEDOWN: return VK_NEXT;
+            case KEY_LEFT: return VK_LEFT;
+            case KEY_RIGHT: return VK_RIGHT;
+            case KEY_UP: return VK_UP;
+            case KEY_DOWN: return VK_DOWN;
+            // Low-level hooks on Windows report the left/right variants of the modifiers
+            case KEY_LEFTSHIFT: return VK_LSHIFT;
+            case KEY_RIGHTSHIFT: return VK_RSHIFT;
+            case KEY_LEFTCTRL: return VK_LCONTROL;
+            case KEY_RIGHTCTRL: return VK_RCONTROL;
+            case KEY_LEFTALT: return VK_LMENU;
+            case KEY_RIGHTALT: return VK_RMENU;
+            case KEY_LEFTMETA: return VK_LWIN;
+            case KEY_RIGHTMETA: return VK_RWIN;
+            case KEY_COMPOSE: return VK_APPS;
+            case KEY_CAPSLOCK: return VK_CAPITAL;
+            case KEY_NUMLOCK: return VK_NUMLOCK;
+            case KEY_SCROLLLOCK: return VK_SCROLL;
+            case KEY_PAUSE: return VK_PAUSE;
+            case KEY_SYSRQ: return VK_SNAPSHOT;
+            case KEY_F1: return VK_F1;
+            case KEY_F2: return VK_F2;
+            case KEY_F3: return VK_F3;
+            case KEY_F4: return VK_F4;
+            case KEY_F5: return VK_F5;
+            case KEY_F6: return VK_F6;
+            case KEY_F7: return VK_F7;
+            case KEY_F8: return VK_F8;
+            case KEY_F9: return VK_F9;
+            case KEY_F10: return VK_F10;
+            case KEY_F11: return VK_F11;
+            case KEY_F12: return VK_F12;
+            case KEY_KP0: return VK_NUMPAD0;
+            case KEY_KP1: return VK_NUMPAD0 + 1;
+            case KEY_KP2: return VK_NUMPAD0 + 2;
+            case KEY_KP3: return VK_NUMPAD0 + 3;
+            case KEY_KP4: return VK_NUMPAD0 + 4;
+            case KEY_KP5: return VK_NUMPAD0 + 5;
+            case KEY_KP6: return VK_NUMPAD0 + 6;
+            case KEY_KP7: return VK_NUMPAD0 + 7;
+            case KEY_KP8: return VK_NUMPAD0 + 8;
+            case KEY_KP9: return VK_NUMPAD0 + 9;
+            case KEY_KPASTERISK: return VK_MULTIPLY;
+            case KEY_KPPLUS: return VK_ADD;
+            case KEY_KPMINUS: return VK_SUBTRACT;
+            case KEY_KPDOT: return VK_DECIMAL;
+            case KEY_KPSLASH: return VK_DIVIDE;
+            case KEY_KPENTER: return VK_RETURN;
+            case KEY_SEMICOLON: return VK_OEM_1;
+            case KEY_EQUAL: return VK_OEM_PLUS;
+            case KEY_COMMA: return VK_OEM_COMMA;
+            case KEY_MINUS: return VK_OEM_MINUS;
+            case KEY_DOT: return VK_OEM_PERIOD;
+            case KEY_SLASH: return VK_OEM_2;
+            case KEY_GRAVE: return VK_OEM_3;
+            case KEY_LEFTBRACE: return VK_OEM_4;
+            case KEY_BACKSLASH: return VK_OEM_5;
+            case KEY_RIGHTBRACE: return VK_OEM_6;
+            case KEY_APOSTROPHE: return VK_OEM_7;
+            default: return 0;
+        }
+    }
+}
+
+LinuxInputHook::LinuxInputHook()
+    : epollFd(-1), inotifyFd(-1), wakeFd(-1) {
+}
+
+LinuxInputHook::~LinuxInputHook() {
+    stop();
+}
+
+bool LinuxInputHook::setKeyboardCallback(KeyPressCallback callback) {
+    bool enable = static_cast<bool>(callback);
+    bool otherActive = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        onKeyPress = std::move(callback);
+        otherActive = static_cast<bool>(onMouseClick);
+    }
+    if (!enable) {
+        if (!otherActive) {
+            stop();
+        }
+        return true;
+    }
+    if (!start()) {
+        return false;
+    }
+    if (!hasDevice(true)) {
+        // Still listening: one may be plugged in (or made readable) later
+        LOG_WARNING("[LinuxInputHook] No readable keyboard in /dev/input yet (is the user in the 'input' group?)");
+    }
+    return true;
+}
+
+bool LinuxInputHook::setMouseCallback(MouseClickCallback callback) {
+    bool enable = static_cast<bool>(callback);
+    bool otherActive = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        onMouseClick = std::move(callback);
+        otherActive = static_cast<bool>(onKeyPress);
+    }
+    if (!enable) {
+        if (!otherActive) {
+            stop();
+        }
+        return true;
+    }
+    if (!start()) {
+        return false;
+    }
+    if (!hasDevice(false)) {
+        // Still listening: one may be plugged in (or made readable) later
+        LOG_WARNING("[LinuxInputHook] No readable mouse in /dev/input yet (is the user in the 'input' group?)");
+    }
+    return true;
+}
+
+bool LinuxInputHook::start() {
+    if (readerThread.joinable()) {
+        return true;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        LOG_ERROR("[LinuxInputHook] Failed to create epoll/eventfd: " + std::string(std::strerror(errno)));
+        stop();
+        return false;
+    }
+
+    epoll_event wakeEvent{};
+    wakeEvent.events = EPOLLIN;
+    wakeEvent.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &wakeEvent);
+
+    // Hotplug: devices appear as eventN, and udev fixes their permissions just after (IN_ATTRIB)
+    if (inotifyFd >= 0 && inotify_add_watch(inotifyFd, INPUT_DIRECTORY, IN_CREATE | IN_ATTRIB) >= 0) {
+        epoll_event hotplugEvent{};
+        hotplugEvent.events = EPOLLIN;
+        hotplugEvent.data.fd = inotifyFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, inotifyFd, &hotplugEvent);
+    } else {
+        LOG_WARNING("[LinuxInputHook] Can't watch /dev/input, devices plugged in later won't be seen");
+    }
+
+    // Scan before the thread starts so callers can check what was found straight away
+    scanDevices();
+
+    readerThread = std::thread(&LinuxInputHook::run, this);
+    return true;
+}
+
+void LinuxInputHook::stop() {
+    if (readerThread.joinable()) {
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+            LOG_WARNING("[LinuxInputHook] Failed to wake input thread");
+        }
+        readerThread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : devices) {
+        close(entry.first);
+    }
+    devices.clear();
+    for (int* fd : {&epollFd, &inotifyFd, &wakeFd}) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+void LinuxInputHook::run() {
+    std::array<epoll_event, MAX_EPOLL_EVENTS> ready;
+    while (true) {
+        int count = epoll_wait(epollFd, ready.data(), static_cast<int>(ready.size()), -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("[LinuxInputHook] epoll_wait failed: " + std::string(std::strerror(errno)));
+            return;
+        }
+
+        for (int i = 0; i < count; i++) {
+            int fd = ready[i].data.fd;
+            if (fd == wakeFd) {
+                return;
+            }
+            if (fd == inotifyFd) {
+                readHotplugEvents();
+            } else if (ready[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeDevice(fd);
+            } else {
+                readDevice(fd);
+            }
+        }
+    }
+}
+
+void LinuxInputHook::scanDevices() {
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(INPUT_DIRECTORY, error)) {
+        if (isEventDevice(entry.path().filename().string())) {
+            openDevice(entry.path().string());
+        }
+    }
+    if (error) {
+        LOG_WARNING("[LinuxInputHook] Failed to list /dev/input: " + error.message());
+    }
+}
+
+void LinuxInputHook::openDevice(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& entry : devices) {
+            if (entry.second.path == path) {
+                return;
+            }
+        }
+    }
+
+    int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        // Usually a permission problem, or udev hasn't finished with the node yet (IN_ATTRIB retries)
+        return;
+    }
+
+    // Keep only devices with keys or mouse buttons (skips lid switches, power buttons without keys, etc.)
+    unsigned long eventBits[bitsToLongs(EV_MAX + 1)] = {};
+    unsigned long keyBits[bitsToLongs(KEY_MAX + 1)] = {};
+    if (ioctl(fd, EVIOCGBIT(0, sizeof(eventBits)), eventBits) < 0 || !testBit(eventBits, EV_KEY) ||
+        ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0) {
+        close(fd);
+        return;
+    }
+    Device device;
+    device.path = path;
+    device.keyboard = testBit(keyBits, KEY_A) && testBit(keyBits, KEY_SPACE);
+    device.mouse = testBit(keyBits, BTN_LEFT);
+    if (!device.keyboard && !device.mouse) {
+        close(fd);
+        return;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        close(fd);
+        return;
+    }
+
+    char name[256] = "unknown";
+    ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name);
+    LOG_INFO("[LinuxInputHook] Reading " + std::string(device.keyboard ? "keyboard" : "mouse") + " " + path + " (" + name + ")");
+
+    std::lock_guard<std::mutex> lock(mutex);
+    devices[fd] = device;
+}
+
+void LinuxInputHook::closeDevice(int fd) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = devices.find(fd);
+    if (it != devices.end()) {
+        LOG_INFO("[LinuxInputHook] Device removed: " + it->second.path);
+        devices.erase(it);
+    }
+}
+
+void LinuxInputHook::readDevice(int fd) {
+    std::array<input_event, EVENTS_PER_READ> events;
+    while (true) {
+        ssize_t bytes = read(fd, events.data(), sizeof(events));
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                // ENODEV when the device was unplugged
+                closeDevice(fd);
+            }
+            return;
+        }
+        if (bytes == 0) {
+            closeDevice(fd);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t count = static_cast<size_t>(bytes) / sizeof(input_event);
+        for (size_t i = 0; i < count; i++) {
+            const input_event& event = events[i];
+            // value: 1 press, 0 release, 2 autorepeat (ignored, the callbacks track held keys themselves)
+            if (event.type != EV_KEY || event.value == 2) {
+                continue;
+            }
+            bool isPressed = event.value == 1;
+
+            if (event.code == BTN_LEFT || event.code == BTN_RIGHT || event.code == BTN_MIDDLE) {
+                if (onMouseClick) {
+                    ButtonType button = event.code == BTN_LEFT ? BUTTON_LEFT : event.code == BTN_RIGHT ? BUTTON_RIGHT : BUTTON_MIDDLE;
+                    onMouseClick(button, isPressed);
+                }
+            } else if (onKeyPress) {
+                unsigned int keyCode = toVirtualKey(event.code);
+                if (keyCode != 0) {
+                    onKeyPress(keyCode, isPressed);
+                }
+            }
+        }
+
+        if (count < events.size()) {
+            return; // Drained
+        }
+    }
+}
+
+void LinuxInputHook::readHotplugEvents() {
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t bytes = read(inotifyFd, buffer, sizeof(buffer));
+        if (bytes <= 0) {
+            return;
+        }
+        for (char* pointer = buffer; pointer < buffer + bytes;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(pointer);
+            pointer += sizeof(inotify_event) + event->len;
+
+            if (event->len == 0 || !isEventDevice(event->name)) {
+                continue;
+            }
+            std::string path = std::string(INPUT_DIRECTORY) + "/" + event->name;
+            if (event->mask & (IN_CREATE | IN_ATTRIB)) {
+                openDevice(path);
+            }
+            // Removal needs no watch: the device's fd reports an error and is closed by run()
+        }
+    }
+}
+
+bool LinuxInputHook::hasDevice(bool keyboard) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& entry : devices) {
+        if (keyboard ? entry.second.keyboard : entry.second.mouse) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // __linux__
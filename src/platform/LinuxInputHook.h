@@ -0,0 +1,73 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Global keyboard and mouse input on Linux, read straight from the evdev devices in
+// /dev/input (the user needs read access, usually via the "input" group).
+// One thread serves every device: it waits on epoll, drains each ready device with
+// batched read()s of input_event arrays and follows hotplug through inotify.
+// Keyboard and mouse share the thread; it runs while either callback is set.
+// Callbacks are invoked on that thread.
+class LinuxInputHook {
+public:
+    enum ButtonType {
+        BUTTON_LEFT = 0,
+        BUTTON_RIGHT = 1,
+        BUTTON_MIDDLE = 2
+    };
+
+    // keyCode is a Windows virtual key code (see VirtualKeyCodes.h)
+    using KeyPressCallback = std::function<void(unsigned int keyCode, bool isPressed)>;
+    using MouseClickCallback = std::function<void(ButtonType button, bool isPressed)>;
+
+    static LinuxInputHook& getInstance() {
+        static LinuxInputHook instance;
+        return instance;
+    }
+
+    // Set or clear (nullptr) a callback. Returns false if the reader couldn't be started;
+    // with no readable device yet it keeps listening for one and logs a warning.
+    bool setKeyboardCallback(KeyPressCallback callback);
+    bool setMouseCallback(MouseClickCallback callback);
+
+private:
+    struct Device {
+        std::string path;
+        bool keyboard;
+        bool mouse;
+    };
+
+    LinuxInputHook();
+    ~LinuxInputHook();
+    LinuxInputHook(const LinuxInputHook&) = delete;
+    LinuxInputHook& operator=(const LinuxInputHook&) = delete;
+
+    bool start();
+    void stop();
+    void run();
+
+    void scanDevices();
+    void openDevice(const std::string& path);
+    void closeDevice(int fd);
+    void readDevice(int fd);
+    void readHotplugEvents();
+    bool hasDevice(bool keyboard) const;
+
+    std::thread readerThread;
+    int epollFd;
+    int inotifyFd;
+    int wakeFd; // eventfd that stops the reader
+
+    std::map<int, Device> devices; // By file descriptor
+    mutable std::mutex mutex;      // Guards devices and the callbacks
+    KeyPressCallback onKeyPress;
+    MouseClickCallback onMouseClick;
+};
+
+#endif // __linux__
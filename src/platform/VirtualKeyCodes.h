@@ -0,0 +1,73 @@
+#pragma once
+
+#ifndef _WIN32
+
+// Windows virtual key codes for platforms without windows.h.
+// Key statistics are stored by virtual key code, so other platforms' hooks translate
+// their native codes to these and the stats files stay the same everywhere.
+namespace VirtualKey {
+    constexpr unsigned int VK_BACK = 0x08;
+    constexpr unsigned int VK_TAB = 0x09;
+    constexpr unsigned int VK_RETURN = 0x0D;
+    constexpr unsigned int VK_SHIFT = 0x10;
+    constexpr unsigned int VK_CONTROL = 0x11;
+    constexpr unsigned int VK_MENU = 0x12;
+    constexpr unsigned int VK_PAUSE = 0x13;
+    constexpr unsigned int VK_CAPITAL = 0x14;
+    constexpr unsigned int VK_ESCAPE = 0x1B;
+    constexpr unsigned int VK_SPACE = 0x20;
+    constexpr unsigned int VK_PRIOR = 0x21;
+    constexpr unsigned int VK_NEXT = 0x22;
+    constexpr unsigned int VK_END = 0x23;
+    constexpr unsigned int VK_HOME = 0x24;
+    constexpr unsigned int VK_LEFT = 0x25;
+    constexpr unsigned int VK_UP = 0x26;
+    constexpr unsigned int VK_RIGHT = 0x27;
+    constexpr unsigned int VK_DOWN = 0x28;
+    constexpr unsigned int VK_SNAPSHOT = 0x2C;
+    constexpr unsigned int VK_INSERT = 0x2D;
+    constexpr unsigned int VK_DELETE = 0x2E;
+    constexpr unsigned int VK_LWIN = 0x5B;
+    constexpr unsigned int VK_RWIN = 0x5C;
+    constexpr unsigned int VK_APPS = 0x5D;
+    constexpr unsigned int VK_NUMPAD0 = 0x60;
+    constexpr unsigned int VK_NUMPAD9 = 0x69;
+    constexpr unsigned int VK_MULTIPLY = 0x6A;
+    constexpr unsigned int VK_ADD = 0x6B;
+    constexpr unsigned int VK_SUBTRACT = 0x6D;
+    constexpr unsigned int VK_DECIMAL = 0x6E;
+    constexpr unsigned int VK_DIVIDE = 0x6F;
+    constexpr unsigned int VK_F1 = 0x70;
+    constexpr unsigned int VK_F2 = 0x71;
+    constexpr unsigned int VK_F3 = 0x72;
+    constexpr unsigned int VK_F4 = 0x73;
+    constexpr unsigned int VK_F5 = 0x74;
+    constexpr unsigned int VK_F6 = 0x75;
+    constexpr unsigned int VK_F7 = 0x76;
+    constexpr unsigned int VK_F8 = 0x77;
+    constexpr unsigned int VK_F9 = 0x78;
+    constexpr unsigned int VK_F10 = 0x79;
+    constexpr unsigned int VK_F11 = 0x7A;
+    constexpr unsigned int VK_F12 = 0x7B;
+    constexpr unsigned int VK_NUMLOCK = 0x90;
+    constexpr unsigned int VK_SCROLL = 0x91;
+    constexpr unsigned int VK_LSHIFT = 0xA0;
+    constexpr unsigned int VK_RSHIFT = 0xA1;
+    constexpr unsigned int VK_LCONTROL = 0xA2;
+    constexpr unsigned int VK_RCONTROL = 0xA3;
+    constexpr unsigned int VK_LMENU = 0xA4;
+    constexpr unsigned int VK_RMENU = 0xA5;
+    constexpr unsigned int VK_OEM_1 = 0xBA;      // ;:
+    constexpr unsigned int VK_OEM_PLUS = 0xBB;   // =+
+    constexpr unsigned int VK_OEM_COMMA = 0xBC;  // ,<
+    constexpr unsigned int VK_OEM_MINUS = 0xBD;  // -_
+    constexpr unsigned int VK_OEM_PERIOD = 0xBE; // .>
+    constexpr unsigned int VK_OEM_2 = 0xBF;      // /?
+    constexpr unsigned int VK_OEM_3 = 0xC0;      // `~
+    constexpr unsigned int VK_OEM_4 = 0xDB;      // [{
+    constexpr unsigned int VK_OEM_5 = 0xDC;      // \|
+    constexpr unsigned int VK_OEM_6 = 0xDD;      // ]}
+    constexpr unsigned int VK_OEM_7 = 0xDE;      // '"
+}
+
+#endif // !_WIN32
@@ -0,0 +1,176 @@
+#include "ui/CounterDisplay.h"
+#include "utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+    // The strip is composited onto transparent, so its texels are premultiplied
+    const sf::BlendMode PREMULTIPLIED_ALPHA(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha);
+}
+
+CounterDisplay::CounterDisplay()
+    : glyphs{}, inkTop(0.0f), inkBottom(0.0f), vertices{}, vertexCount(0),
+      color(sf::Color::Black), value(0), ready(false) {
+}
+
+bool CounterDisplay::initialize(const sf::Font& font, unsigned int characterSize) {
+    ready = false;
+    
+    const char32_t codepoints[12] = {U'0', U'1', U'2', U'3', U'4', U'5', U'6', U'7', U'8', U'9', U' ', U'-'};
+    
+    // Load every glyph before taking the page texture - loading may grow the page
+    std::array<sf::Glyph, 12> fontGlyphs;
+    for (size_t i = 0; i < fontGlyphs.size(); i++) {
+        fontGlyphs[i] = font.getGlyph(codepoints[i], characterSize, false);
+    }
+    const sf::Texture& page = font.getTexture(characterSize);
+    
+    // Lay the glyphs out side by side with a pixel of padding between them
+    const int padding = 1;
+    int stripWidth = padding;
+    int stripHeight = 1;
+    for (const sf::Glyph& glyph : fontGlyphs) {
+        stripWidth += glyph.textureRect.size.x + padding;
+        stripHeight = std::max(stripHeight, glyph.textureRect.size.y + padding * 2);
+    }
+    if (!strip.resize(sf::Vector2u(static_cast<unsigned int>(stripWidth), static_cast<unsigned int>(stripHeight)))) {
+        LOG_WARNING("[CounterDisplay] Failed to create digit glyph strip");
+        return false;
+    }
+    
+    strip.clear(sf::Color::Transparent);
+    int x = padding;
+    inkTop = 0.0f;
+    inkBottom = 0.0f;
+    for (size_t i = 0; i < fontGlyphs.size(); i++) {
+        const sf::Glyph& glyph = fontGlyphs[i];
+        
+        sf::Sprite glyphSprite(page, glyph.textureRect);
+        glyphSprite.setPosition(sf::Vector2f(static_cast<float>(x), static_cast<float>(padding)));
+        strip.draw(glyphSprite);
+        
+        glyphs[i].textureRect = sf::FloatRect(glyphSprite.getPosition(), sf::Vector2f(glyph.textureRect.size));
+        glyphs[i].bounds = glyph.bounds;
+        glyphs[i].advance = glyph.advance;
+        x += glyph.textureRect.size.x + padding;
+        
+        if (i < GLYPH_SPACE) {
+            inkTop = std::min(inkTop, glyph.bounds.position.y);
+            inkBottom = std::max(inkBottom, glyph.bounds.position.y + glyph.bounds.size.y);
+        }
+    }
+    strip.display();
+    
+    ready = true;
+    layout();
+    return true;
+}
+
+void CounterDisplay::setColor(sf::Color newColor) {
+    if (newColor == color) {
+        return;
+    }
+    color = newColor;
+    layout();
+}
+
+void CounterDisplay::setBox(const sf::FloatRect& newBox) {
+    if (newBox == box) {
+        return;
+    }
+    box = newBox;
+    layout();
+}
+
+void CounterDisplay::setValue(int newValue) {
+    if (newValue == value) {
+        return;
+    }
+    value = newValue;
+    layout();
+}
+
+void CounterDisplay::layout() {
+    vertexCount = 0;
+    if (!ready) {
+        return;
+    }
+    
+    // Format with a space every 3 digits from the right (e.g. "4 309"), written backwards
+    size_t chars[MAX_CHARS];
+    size_t charCount = 0;
+    long long magnitude = std::llabs(static_cast<long long>(value));
+    int digitCount = 0;
+    do {
+        if (digitCount > 0 && digitCount % 3 == 0) {
+            chars[charCount++] = GLYPH_SPACE;
+        }
+        chars[charCount++] = static_cast<size_t>(magnitude % 10);
+        magnitude /= 10;
+        digitCount++;
+    } while (magnitude > 0);
+    if (value < 0) {
+        chars[charCount++] = GLYPH_MINUS;
+    }
+    std::reverse(chars, chars + charCount);
+    
+    // Measure the ink extent so the text is centered exactly
+    float pen = 0.0f;
+    float inkLeft = 0.0f;
+    float inkRight = 0.0f;
+    for (size_t i = 0; i < charCount; i++) {
+        const GlyphInfo& glyph = glyphs[chars[i]];
+        if (i == 0) {
+            inkLeft = pen + glyph.bounds.position.x;
+        }
+        inkRight = std::max(inkRight, pen + glyph.bounds.position.x + glyph.bounds.size.x);
+        pen += glyph.advance;
+    }
+    
+    // Snap to whole pixels so the glyphs map 1:1 onto the strip
+    float originX = std::round(box.position.x + (box.size.x - (inkRight - inkLeft)) / 2.0f - inkLeft);
+    float baselineY = std::round(box.position.y + (box.size.y - (inkBottom - inkTop)) / 2.0f - inkTop);
+    
+    sf::Color vertexColor(
+        static_cast<std::uint8_t>(color.r * color.a / 255),
+        static_cast<std::uint8_t>(color.g * color.a / 255),
+        static_cast<std::uint8_t>(color.b * color.a / 255),
+        color.a
+    );
+    
+    pen = originX;
+    for (size_t i = 0; i < charCount; i++) {
+        const GlyphInfo& glyph = glyphs[chars[i]];
+        
+        float left = pen + glyph.bounds.position.x;
+        float top = baselineY + glyph.bounds.position.y;
+        float right = left + glyph.bounds.size.x;
+        float bottom = top + glyph.bounds.size.y;
+        
+        float texLeft = glyph.textureRect.position.x;
+        float texTop = glyph.textureRect.position.y;
+        float texRight = texLeft + glyph.textureRect.size.x;
+        float texBottom = texTop + glyph.textureRect.size.y;
+        
+        vertices[vertexCount++] = sf::Vertex{sf::Vector2f(left, top), vertexColor, sf::Vector2f(texLeft, texTop)};
+        vertices[vertexCount++] = sf::Vertex{sf::Vector2f(right, top), vertexColor, sf::Vector2f(texRight, texTop)};
+        vertices[vertexCount++] = sf::Vertex{sf::Vector2f(left, bottom), vertexColor, sf::Vector2f(texLeft, texBottom)};
+        vertices[vertexCount++] = sf::Vertex{sf::Vector2f(left, bottom), vertexColor, sf::Vector2f(texLeft, texBottom)};
+        vertices[vertexCount++] = sf::Vertex{sf::Vector2f(right, top), vertexColor, sf::Vector2f(texRight, texTop)};
+        vertices[vertexCount++] = sf::Vertex{sf::Vector2f(right, bottom), vertexColor, sf::Vector2f(texRight, texBottom)};
+        
+        pen += glyph.advance;
+    }
+}
+
+void CounterDisplay::draw(sf::RenderTarget& target) const {
+    if (!ready || vertexCount == 0) {
+        return;
+    }
+    
+    sf::RenderStates states(PREMULTIPLIED_ALPHA);
+    states.texture = &strip.getTexture();
+    target.draw(vertices.data(), vertexCount, sf::PrimitiveType::Triangles, states);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstddef>
+
+// Draws the punch counter ("4 309") from a strip of pre-baked digit glyphs.
+// The quads are laid out only when the value or the box changes, with the width
+// measured from the glyphs themselves, so an unchanged counter costs no work per frame.
+class CounterDisplay {
+public:
+    CounterDisplay();
+    
+    // Bake the digit, space and minus glyphs of font at characterSize.
+    // The font isn't referenced afterwards. Returns false if the strip couldn't be created.
+    bool initialize(const sf::Font& font, unsigned int characterSize);
+    
+    void setColor(sf::Color color);
+    void setBox(const sf::FloatRect& box); // Area the text is centered in
+    void setValue(int value);
+    
+    void draw(sf::RenderTarget& target) const;
+    
+private:
+    struct GlyphInfo {
+        sf::FloatRect textureRect; // Position in the strip
+        sf::FloatRect bounds;      // Relative to the pen position on the baseline
+        float advance;
+    };
+    
+    // Enough for any int: sign, 10 digits and 3 group separators
+    static constexpr size_t MAX_CHARS = 16;
+    static constexpr size_t GLYPH_SPACE = 10;
+    static constexpr size_t GLYPH_MINUS = 11;
+    
+    sf::RenderTexture strip;
+    std::array<GlyphInfo, 12> glyphs; // '0'-'9', ' ', '-'
+    float inkTop;    // Topmost digit pixel relative to the baseline
+    float inkBottom; // Bottommost digit pixel relative to the baseline
+    
+    std::array<sf::Vertex, MAX_CHARS * 6> vertices; // Two triangles per character
+    size_t vertexCount;
+    
+    sf::FloatRect box;
+    sf::Color color;
+    int value;
+    bool ready;
+    
+    void layout();
+};
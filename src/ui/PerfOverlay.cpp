@@ -0,0 +1,144 @@
+#include "ui/PerfOverlay.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr unsigned int CHARACTER_SIZE = 10;
+    constexpr float PADDING = 3.0f;
+
+    // Resident set size of this process in bytes, 0 if unknown
+    size_t getResidentMemory() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return counters.WorkingSetSize;
+        }
+        return 0;
+#elif defined(__APPLE__)
+        mach_task_basic_info_data_t info{};
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS) {
+            return info.resident_size;
+        }
+        return 0;
+#else
+        // Second field of statm is resident pages
+        std::ifstream statm("/proc/self/statm");
+        size_t totalPages = 0;
+        size_t residentPages = 0;
+        if (statm >> totalPages >> residentPages) {
+            return residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        }
+        return 0;
+#endif
+    }
+}
+
+PerfOverlay::PerfOverlay(const sf::Font& font)
+    : visible(false), text(font, "", CHARACTER_SIZE), frameSamples{}, frameSampleCount(0), frameSampleIndex(0),
+      framesSinceRefresh(0), framesPerSecond(0.0f), lastLatencyMs(-1.0f), lastSaveTime(Clock::duration::zero()) {
+    text.setFillColor(sf::Color(230, 230, 230));
+    text.setPosition(sf::Vector2f(PADDING, PADDING));
+    // Opaque: anything blended over the magenta color key would tint the window
+    background.setFillColor(sf::Color(30, 30, 30));
+}
+
+void PerfOverlay::setVisible(bool newVisible) {
+    if (newVisible == visible) {
+        return;
+    }
+    visible = newVisible;
+    if (visible) {
+        // Start from fresh numbers and format on the next update
+        resetSamples();
+        lastRefresh = Clock::time_point();
+    }
+}
+
+void PerfOverlay::resetSamples() {
+    frameSampleCount = 0;
+    frameSampleIndex = 0;
+    framesSinceRefresh = 0;
+    framesPerSecond = 0.0f;
+    lastLatencyMs = -1.0f;
+}
+
+void PerfOverlay::recordFrame(Clock::duration frameTime) {
+    if (!visible) {
+        return;
+    }
+    frameSamples[frameSampleIndex] = std::chrono::duration<float, std::milli>(frameTime).count();
+    frameSampleIndex = (frameSampleIndex + 1) % FRAME_SAMPLE_COUNT;
+    if (frameSampleCount < FRAME_SAMPLE_COUNT) {
+        frameSampleCount++;
+    }
+    framesSinceRefresh++;
+}
+
+void PerfOverlay::recordInputLatency(Clock::duration latency) {
+    if (!visible) {
+        return;
+    }
+    lastLatencyMs = std::chrono::duration<float, std::milli>(latency).count();
+}
+
+bool PerfOverlay::update(const Gauges& gauges) {
+    if (!visible) {
+        return false;
+    }
+    Clock::time_point now = Clock::now();
+    if (now - lastRefresh < REFRESH_INTERVAL) {
+        return false;
+    }
+    if (lastRefresh != Clock::time_point()) {
+        framesPerSecond = static_cast<float>(framesSinceRefresh) / std::chrono::duration<float>(now - lastRefresh).count();
+    }
+    framesSinceRefresh = 0;
+    lastRefresh = now;
+
+    float p50 = 0.0f;
+    float p99 = 0.0f;
+    if (frameSampleCount > 0) {
+        std::array<float, FRAME_SAMPLE_COUNT> sorted = frameSamples;
+        std::sort(sorted.begin(), sorted.begin() + frameSampleCount);
+        p50 = sorted[(frameSampleCount * 50) / 100];
+        p99 = sorted[std::min(frameSampleCount - 1, (frameSampleCount * 99) / 100)];
+    }
+
+    char latency[16] = "-";
+    if (lastLatencyMs >= 0.0f) {
+        std::snprintf(latency, sizeof(latency), "%.1f ms", lastLatencyMs);
+    }
+
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "FPS %.0f\nframe p50 %.2f  p99 %.2f ms\ninput->punch %s\nqueue %zu  voices %zu\nsave %.1f ms\nRSS %.1f MB",
+                  framesPerSecond, p50, p99, latency, gauges.inputQueueDepth, gauges.activeVoices,
+                  std::chrono::duration<float, std::milli>(lastSaveTime).count(),
+                  static_cast<double>(getResidentMemory()) / (1024.0 * 1024.0));
+    text.setString(buffer);
+
+    sf::FloatRect textBounds = text.getGlobalBounds();
+    background.setSize(sf::Vector2f(textBounds.position.x + textBounds.size.x + PADDING,
+                                    textBounds.position.y + textBounds.size.y + PADDING));
+    return true;
+}
+
+void PerfOverlay::draw(sf::RenderTarget& target) const {
+    if (!visible) {
+        return;
+    }
+    target.draw(background);
+    target.draw(text);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// Toggleable performance readout drawn in the cat window (F3), so a lag report can come
+// with numbers: FPS, frame time p50/p99, input-to-present latency, queued punches,
+// playing sounds, the last save's duration and resident memory.
+// While hidden nothing is sampled, formatted or drawn.
+class PerfOverlay {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Values owned by other systems, read when the text is refreshed
+    struct Gauges {
+        size_t inputQueueDepth = 0; // Presses waiting in the input queue when the latest frame drained it
+        size_t activeVoices = 0;
+    };
+
+    // font must outlive the overlay
+    explicit PerfOverlay(const sf::Font& font);
+
+    void setVisible(bool visible);
+    void toggle() { setVisible(!visible); }
+    bool isVisible() const { return visible; }
+
+    // Time from the start of a frame to its present
+    void recordFrame(Clock::duration frameTime);
+    // Time from the hook event to the present of the first frame showing its punch
+    void recordInputLatency(Clock::duration latency);
+    // Recorded even while hidden so the value is there when the overlay is opened
+    void recordSave(Clock::duration saveTime) { lastSaveTime = saveTime; }
+
+    // Re-format the text if it's due (a few times a second). Returns true if it changed.
+    bool update(const Gauges& gauges);
+
+    void draw(sf::RenderTarget& target) const;
+    sf::FloatRect getBounds() const { return background.getGlobalBounds(); }
+
+private:
+    static constexpr size_t FRAME_SAMPLE_COUNT = 128;
+    static constexpr auto REFRESH_INTERVAL = std::chrono::milliseconds(250);
+
+    bool visible;
+    sf::Text text;
+    sf::RectangleShape background;
+
+    std::array<float, FRAME_SAMPLE_COUNT> frameSamples; // Milliseconds
+    size_t frameSampleCount;
+    size_t frameSampleIndex;
+
+    size_t framesSinceRefresh;
+    Clock::time_point lastRefresh;
+    float framesPerSecond;
+    float lastLatencyMs;
+    Clock::duration lastSaveTime;
+
+    void resetSamples();
+};
@@ -0,0 +1,56 @@
+#include "ui/SettingsWindowLifecycle.h"
+#include <algorithm>
+
+SettingsWindowLifecycle::SettingsWindowLifecycle(const Policy& policy, Clock::time_point startTime)
+    : policy(policy), startTime(startTime), lastInputTime(startTime), hiddenSince(startTime),
+      exists(false), visible(false), prewarmDone(!policy.prewarm) {
+}
+
+void SettingsWindowLifecycle::onInput(Clock::time_point when) {
+    lastInputTime = when;
+}
+
+void SettingsWindowLifecycle::onCreated() {
+    exists = true;
+    prewarmDone = true;
+}
+
+void SettingsWindowLifecycle::onShown() {
+    visible = true;
+}
+
+void SettingsWindowLifecycle::onHidden(Clock::time_point when) {
+    visible = false;
+    hiddenSince = when;
+}
+
+void SettingsWindowLifecycle::onDestroyed(Clock::time_point when) {
+    exists = false;
+    visible = false;
+    hiddenSince = when;
+}
+
+bool SettingsWindowLifecycle::shouldPrewarm(Clock::time_point now) const {
+    if (prewarmDone || exists) {
+        return false;
+    }
+    return now - startTime >= policy.prewarmDelay && now - lastInputTime >= policy.prewarmQuietTime;
+}
+
+bool SettingsWindowLifecycle::shouldReclaim(Clock::time_point now) const {
+    if (!exists || visible || policy.reclaimAfter <= Clock::duration::zero()) {
+        return false;
+    }
+    return now - hiddenSince >= policy.reclaimAfter;
+}
+
+SettingsWindowLifecycle::Clock::time_point SettingsWindowLifecycle::getNextDeadline() const {
+    Clock::time_point deadline = Clock::time_point::max();
+    if (!prewarmDone && !exists) {
+        deadline = std::min(deadline, std::max(startTime + policy.prewarmDelay, lastInputTime + policy.prewarmQuietTime));
+    }
+    if (exists && !visible && policy.reclaimAfter > Clock::duration::zero()) {
+        deadline = std::min(deadline, hiddenSince + policy.reclaimAfter);
+    }
+    return deadline;
+}
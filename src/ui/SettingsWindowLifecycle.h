@@ -0,0 +1,45 @@
+#pragma once
+
+#include <chrono>
+
+// Decides when the settings webview should exist. Creating it (Crow server, browser engine,
+// page load) is the slow part of opening settings, and keeping it costs the engine's memory,
+// so both ends are policy: it is created ahead of time once the app has been idle for a bit
+// after startup, and torn down after it has stayed hidden for a while.
+// Pure bookkeeping: the main loop reports what happened and asks what to do.
+class SettingsWindowLifecycle {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    struct Policy {
+        bool prewarm = true;
+        Clock::duration prewarmDelay = std::chrono::seconds(5);     // Earliest, counted from startup
+        Clock::duration prewarmQuietTime = std::chrono::seconds(2); // No input for this long before prewarming
+        Clock::duration reclaimAfter = std::chrono::minutes(5);     // Hidden this long -> torn down (zero keeps it)
+    };
+    
+    SettingsWindowLifecycle(const Policy& policy, Clock::time_point startTime);
+    
+    const Policy& getPolicy() const { return policy; }
+    
+    void onInput(Clock::time_point when);
+    void onCreated();                     // Whether prewarmed or opened by the user
+    void onShown();
+    void onHidden(Clock::time_point when);
+    void onDestroyed(Clock::time_point when);
+    
+    bool shouldPrewarm(Clock::time_point now) const;
+    bool shouldReclaim(Clock::time_point now) const;
+    
+    // When one of the above may next turn true (Clock::time_point::max() if never), for idle waits
+    Clock::time_point getNextDeadline() const;
+    
+private:
+    Policy policy;
+    Clock::time_point startTime;
+    Clock::time_point lastInputTime;
+    Clock::time_point hiddenSince;
+    bool exists;
+    bool visible;
+    bool prewarmDone; // Prewarm at most once; after a reclaim the next open is on demand
+};
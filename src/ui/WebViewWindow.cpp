@@ -1,10 +1,12 @@
 #include "ui/WebViewWindow.h"
+#include "managers/StaticAssetCache.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -32,17 +34,111 @@
 
 WebViewWindow* g_webViewInstance = nullptr;
 
-// Helper function for webview_dispatch to evaluate JavaScript
-static void evalScriptCallback(webview_t w, void* arg) {
-    std::string* script = static_cast<std::string*>(arg);
-    if (script && w) {
-        webview_eval(w, script->c_str());
+// Port of the last settings server, reused by the next one so the page keeps its origin (and the
+// webview its HTTP cache, which the ETag revalidation relies on) for the life of the process
+static std::atomic<int> s_preferredServerPort{0};
+
+#ifdef _WIN32
+// webview_create shows and focuses a window it creates itself, but leaves a window it is given
+// alone: a window that has to start hidden is created here, and the webview embedded in it
+static LRESULT CALLBACK hostWindowProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam) {
+    switch (msg) {
+        case WM_SIZE: {
+            // Keep the webview's child window filling the client area
+            RECT client;
+            GetClientRect(hwnd, &client);
+            if (HWND child = GetWindow(hwnd, GW_CHILD)) {
+                MoveWindow(child, 0, 0, client.right - client.left, client.bottom - client.top, TRUE);
+            }
+            return 0;
+        }
+        case WM_DESTROY:
+            // Closed (Alt+F4): end the webview's loop, as it does for a window of its own
+            PostQuitMessage(0);
+            return 0;
+    }
+    return DefWindowProcW(hwnd, msg, wParam, lParam);
+}
+
+static HWND createHostWindow() {
+    static const wchar_t* const className = L"OpenBongoSettingsHost";
+    static bool registered = false;
+    HINSTANCE instance = GetModuleHandleW(nullptr);
+    if (!registered) {
+        WNDCLASSEXW windowClass = {};
+        windowClass.cbSize = sizeof(windowClass);
+        windowClass.lpfnWndProc = hostWindowProc;
+        windowClass.hInstance = instance;
+        windowClass.hCursor = LoadCursor(nullptr, IDC_ARROW);
+        windowClass.lpszClassName = className;
+        registered = RegisterClassExW(&windowClass) != 0 || GetLastError() == ERROR_CLASS_ALREADY_EXISTS;
     }
-    delete script; // Clean up allocated string
+    // Not WS_VISIBLE; the size is set by webview_set_size
+    return CreateWindowExW(0, className, L"OpenBongo Settings", WS_OVERLAPPEDWINDOW,
+                           CW_USEDEFAULT, CW_USEDEFAULT, 650, 600, nullptr, nullptr, instance, nullptr);
+}
+#endif
+
+// Serve a file from the asset cache, gzipped when the client takes it; a matching If-None-Match gets a bodiless 304
+static crow::response serveAsset(const crow::request& req, const std::filesystem::path& filePath, const std::string& notFoundMessage) {
+    std::shared_ptr<const StaticAssetCache::Asset> asset = StaticAssetCache::getInstance().get(filePath);
+    if (!asset) {
+        return crow::response(404, "text/plain", notFoundMessage);
+    }
+    
+    bool useGzip = !asset->gzipBody.empty() && StaticAssetCache::acceptsGzip(req.get_header_value("Accept-Encoding"));
+    const std::string& etag = useGzip ? asset->gzipETag : asset->etag;
+    
+    crow::response res;
+    res.set_header("ETag", etag);
+    // Revalidate every time: packs can be edited while the app runs, and a 304 costs only a stat
+    res.set_header("Cache-Control", "no-cache");
+    if (!asset->gzipBody.empty()) {
+        res.set_header("Vary", "Accept-Encoding");
+    }
+    if (StaticAssetCache::matchesETag(req.get_header_value("If-None-Match"), etag)) {
+        res.code = 304;
+        return res;
+    }
+    res.set_header("Content-Type", asset->contentType);
+    if (useGzip) {
+        res.set_header("Content-Encoding", "gzip");
+        res.body = asset->gzipBody;
+    } else {
+        res.body = asset->body;
+    }
+    return res;
+}
+
+// Stream a file from disk in chunks (Crow's static file body) instead of loading it into memory.
+// filePath must already be confined to its directory.
+static crow::response serveFile(const crow::request& req, const std::filesystem::path& filePath) {
+    std::error_code ec;
+    std::uintmax_t fileSize = std::filesystem::file_size(filePath, ec);
+    std::filesystem::file_time_type writeTime;
+    if (!ec) {
+        writeTime = std::filesystem::last_write_time(filePath, ec);
+    }
+    if (ec) {
+        return crow::response(404, "text/plain", "File not found");
+    }
+    
+    std::string etag = StaticAssetCache::makeFileETag(fileSize, writeTime);
+    crow::response res;
+    res.set_header("ETag", etag);
+    res.set_header("Cache-Control", "no-cache");
+    if (StaticAssetCache::matchesETag(req.get_header_value("If-None-Match"), etag)) {
+        res.code = 304;
+        return res;
+    }
+    // Sets Content-Type and Content-Length; the body is read and written one buffer at a time
+    res.set_static_file_info(filePath.generic_string());
+    return res;
 }
 
 WebViewWindow::WebViewWindow() 
-    : m_webview(nullptr), m_app(nullptr), m_serverRunning(false), m_serverPort(0), m_initialized(false), m_shuttingDown(false) {
+    : m_webview(nullptr), m_app(nullptr), m_serverRunning(false), m_serverPort(0), m_initialized(false), m_shuttingDown(false),
+      m_uiLoopRunning(false), m_flushScheduled(false), m_hostWindow(nullptr) {
     g_webViewInstance = this;
 }
 
@@ -66,25 +162,26 @@ bool WebViewWindow::initialize(void* parentHwnd, const std::string& htmlPath) {
     m_uiDirectory = htmlFilePath.parent_path().string();
     
     try {
-        // Start Crow HTTP server in a separate thread
-        startServer();
-        
-        // Wait for server to start (poll with timeout instead of fixed sleep)
-        auto startTime = std::chrono::steady_clock::now();
-        const auto timeout = std::chrono::milliseconds(500);
-        while ((std::chrono::steady_clock::now() - startTime) < timeout) {
-            if (m_serverRunning && m_serverPort > 0) {
-                break;
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // Start Crow HTTP server in a separate thread and wait until it is listening
+        auto serverStarted = [this]() {
+            std::future<int> serverPort = startServer();
+            return serverPort.wait_for(std::chrono::seconds(3)) == std::future_status::ready && serverPort.get() != 0;
+        };
+        bool started = serverStarted();
+        if (!started && s_preferredServerPort != 0) {
+            // The previous port was taken in the meantime: let the OS pick a new one
+            s_preferredServerPort = 0;
+            stopServer();
+            started = serverStarted();
         }
-        
-        if (!m_serverRunning || m_serverPort == 0) {
+        if (!started) {
             std::cerr << "Failed to start Crow server" << std::endl;
+            stopServer();
             return false;
         }
+        s_preferredServerPort = m_serverPort.load();
         
-        // Create webview pointing to localhost
+        // Create webview pointing to the loopback server
         m_webview = webview_create(0, parentHwnd);
         if (!m_webview) {
             std::cerr << "Failed to create webview" << std::endl;
@@ -99,8 +196,8 @@ bool WebViewWindow::initialize(void* parentHwnd, const std::string& htmlPath) {
         // Bind message handler
         webview_bind(m_webview, "postMessage", messageCallback, this);
         
-        // Navigate to localhost
-        std::string url = "http://localhost:" + std::to_string(m_serverPort) + "/";
+        // Navigate to the loopback server
+        std::string url = "http://127.0.0.1:" + std::to_string(m_serverPort) + "/";
         webview_navigate(m_webview, url.c_str());
         
         
@@ -112,66 +209,101 @@ bool WebViewWindow::initialize(void* parentHwnd, const std::string& htmlPath) {
     }
 }
 
-void WebViewWindow::startServer() {
+void WebViewWindow::openAsync(const std::string& htmlPath, bool startHidden, std::function<void(bool created)> onCreated) {
+#ifdef __APPLE__
+    // The app's event loop pumps the window, as it does for the cat window
+    bool created = initialize(nullptr, htmlPath);
+    if (onCreated) {
+        onCreated(created);
+    }
+#else
+    if (m_uiThread.joinable()) {
+        return;
+    }
+    m_uiThread = std::thread([this, htmlPath, startHidden, onCreated]() {
+        void* parentWindow = nullptr;
+        #ifdef _WIN32
+        // The host window belongs to this thread, like the webview's own window would
+        if (startHidden) {
+            m_hostWindow = createHostWindow();
+            parentWindow = m_hostWindow ? &m_hostWindow : nullptr;
+        }
+        #endif
+        bool created = initialize(parentWindow, htmlPath);
+        if (onCreated) {
+            onCreated(created);
+        }
+        
+        bool runLoop = false;
+        {
+            std::lock_guard<std::mutex> lock(m_uiLoopMutex);
+            runLoop = created && !m_shuttingDown;
+            m_uiLoopRunning = runLoop;
+        }
+        if (runLoop) {
+            // Until shutdown() terminates it
+            runMessageLoop();
+        }
+        
+        // The webview belongs to this thread, so it is destroyed here
+        std::lock_guard<std::mutex> lock(m_uiLoopMutex);
+        m_uiLoopRunning = false;
+        if (m_webview) {
+            webview_destroy(m_webview);
+            m_webview = nullptr;
+        }
+        #ifdef _WIN32
+        if (m_hostWindow) {
+            HWND host = static_cast<HWND>(m_hostWindow);
+            m_hostWindow = nullptr;
+            if (IsWindow(host)) {
+                DestroyWindow(host);
+            }
+        }
+        #endif
+    });
+#endif
+}
+
+std::future<int> WebViewWindow::startServer() {
     // Ensure any existing server is fully stopped before starting a new one
     if (m_serverThread.joinable() || m_app) {
         stopServer();
-        // Give a small delay to ensure port is released
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
     }
     
     // Reset state before starting
     m_serverPort = 0;
     m_serverRunning = true;
     
-    m_serverThread = std::thread([this]() {
+    // Created here rather than on the server thread so stopServer() never races its creation
+    m_app = std::make_unique<crow::SimpleApp>();
+    
+    std::promise<int> portPromise;
+    std::future<int> portFuture = portPromise.get_future();
+    int requestedPort = s_preferredServerPort;
+    m_serverThread = std::thread([this, requestedPort, portPromise = std::move(portPromise)]() mutable {
+        bool portPublished = false;
         try {
-            // Create Crow app
-            m_app = std::make_unique<crow::SimpleApp>();
             
             // Serve static files from UI directory
             CROW_ROUTE((*m_app), "/")
-            ([this]() {
-                std::ifstream file(m_htmlPath);
-                if (!file.is_open()) {
-                    return crow::response(404, "text/plain", "File not found");
-                }
-                std::stringstream buffer;
-                buffer << file.rdbuf();
-                return crow::response(buffer.str());
+            ([this](const crow::request& req) {
+                return serveAsset(req, m_htmlPath, "File not found");
             });
             
             // Serve CSS files
             CROW_ROUTE((*m_app), "/styles.css")
-            ([this]() {
-                std::string cssPath = m_uiDirectory + "/styles.css";
-                std::ifstream file(cssPath);
-                if (!file.is_open()) {
-                    return crow::response(404, "text/plain", "CSS not found");
-                }
-                std::stringstream buffer;
-                buffer << file.rdbuf();
-                crow::response res(buffer.str());
-                res.set_header("Content-Type", "text/css");
-                return res;
+            ([this](const crow::request& req) {
+                return serveAsset(req, m_uiDirectory + "/styles.css", "CSS not found");
             });
             
             // Serve JS files
             CROW_ROUTE((*m_app), "/app.js")
-            ([this]() {
-                std::string jsPath = m_uiDirectory + "/app.js";
-                std::ifstream file(jsPath);
-                if (!file.is_open()) {
-                    return crow::response(404, "text/plain", "JS not found");
-                }
-                std::stringstream buffer;
-                buffer << file.rdbuf();
-                crow::response res(buffer.str());
-                res.set_header("Content-Type", "application/javascript");
-                return res;
+            ([this](const crow::request& req) {
+                return serveAsset(req, m_uiDirectory + "/app.js", "JS not found");
             });
             
-            // Serve catpack images
+            // Serve catpack images (streamed, not cached)
             CROW_ROUTE((*m_app), "/catpacks/<path>")
             ([](const crow::request& req, std::string path) {
                 try {
@@ -188,39 +320,17 @@ void WebViewWindow::startServer() {
                     }
                     
                     // Check if file exists
-                    if (!std::filesystem::exists(filePath) || !std::filesystem::is_regular_file(filePath)) {
-                        return crow::response(404, "text/plain", "File not found");
-                    }
-                    
-                    std::ifstream file(filePath, std::ios::binary);
-                    if (!file.is_open()) {
+                    if (!std::filesystem::is_regular_file(filePath)) {
                         return crow::response(404, "text/plain", "File not found");
                     }
                     
-                    std::stringstream buffer;
-                    buffer << file.rdbuf();
-                    crow::response res(buffer.str());
-                    
-                    // Set content type based on file extension
-                    std::string ext = filePath.extension().string();
-                    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                    if (ext == ".png") {
-                        res.set_header("Content-Type", "image/png");
-                    } else if (ext == ".jpg" || ext == ".jpeg") {
-                        res.set_header("Content-Type", "image/jpeg");
-                    } else if (ext == ".gif") {
-                        res.set_header("Content-Type", "image/gif");
-                    } else {
-                        res.set_header("Content-Type", "application/octet-stream");
-                    }
-                    
-                    return res;
+                    return serveFile(req, filePath);
                 } catch (const std::exception& e) {
                     return crow::response(500, "text/plain", "Internal server error");
                 }
             });
             
-            // Serve hat images
+            // Serve hat images (streamed, not cached)
             CROW_ROUTE((*m_app), "/hats/<path>")
             ([](const crow::request& req, std::string path) {
                 try {
@@ -237,33 +347,11 @@ void WebViewWindow::startServer() {
                     }
                     
                     // Check if file exists
-                    if (!std::filesystem::exists(filePath) || !std::filesystem::is_regular_file(filePath)) {
-                        return crow::response(404, "text/plain", "File not found");
-                    }
-                    
-                    std::ifstream file(filePath, std::ios::binary);
-                    if (!file.is_open()) {
+                    if (!std::filesystem::is_regular_file(filePath)) {
                         return crow::response(404, "text/plain", "File not found");
                     }
                     
-                    std::stringstream buffer;
-                    buffer << file.rdbuf();
-                    crow::response res(buffer.str());
-                    
-                    // Set content type based on file extension
-                    std::string ext = filePath.extension().string();
-                    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                    if (ext == ".png") {
-                        res.set_header("Content-Type", "image/png");
-                    } else if (ext == ".jpg" || ext == ".jpeg") {
-                        res.set_header("Content-Type", "image/jpeg");
-                    } else if (ext == ".gif") {
-                        res.set_header("Content-Type", "image/gif");
-                    } else {
-                        res.set_header("Content-Type", "application/octet-stream");
-                    }
-                    
-                    return res;
+                    return serveFile(req, filePath);
                 } catch (const std::exception& e) {
                     return crow::response(500, "text/plain", "Internal server error");
                 }
@@ -286,22 +374,32 @@ void WebViewWindow::startServer() {
                 return crow::response(200, "text/plain", "OK");
             });
             
-            // Find an available port and run server
-            int port = 18080;
-            m_serverPort = port;
+            // The first server takes port 0 (the OS picks a free one, so a second instance or another app
+            // can't collide); later ones ask for the same port again. Loopback only, the UI is never
+            // meant to be reachable from the network.
+            std::future<void> server = m_app->port(static_cast<std::uint16_t>(requestedPort)).bindaddr("127.0.0.1").multithreaded().run_async();
+            m_app->wait_for_server_start();
+            int boundPort = m_app->port();
+            // Anything but the requested port (when one was requested) counts as a failed start
+            m_serverPort = (requestedPort == 0 || boundPort == requestedPort) ? boundPort : 0;
+            portPromise.set_value(m_serverPort);
+            portPublished = true;
             
-            // Run the server (this blocks, which is fine in a thread)
-            // The run() call will block until stop() is called
-            m_app->port(port).multithreaded().run();
+            // Blocks until stop() is called
+            server.get();
         } catch (const std::exception& e) {
             std::cerr << "Crow server error: " << e.what() << std::endl;
-            m_serverRunning = false;
             m_serverPort = 0;
         }
         
+        if (!portPublished) {
+            portPromise.set_value(0);
+        }
+        
         // Thread is exiting - mark as not running
         m_serverRunning = false;
     });
+    return portFuture;
 }
 
 void WebViewWindow::stopServer() {
@@ -318,27 +416,13 @@ void WebViewWindow::stopServer() {
         }
     }
     
-    // Wait for the server thread to finish
+    // Wait for the server thread to finish (run_async's future returns once stop() has taken effect)
     if (m_serverThread.joinable()) {
-        // Give the server thread time to exit after stop() is called
-        // The run() method should return after stop() is called
-        auto startTime = std::chrono::steady_clock::now();
-        const auto timeout = std::chrono::seconds(2);
-        
-        // Wait for thread to finish, checking periodically
-        while (m_serverThread.joinable() && 
-               (std::chrono::steady_clock::now() - startTime) < timeout) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-        }
-        
-        // Now join the thread (this will block if thread is still running, but we've waited)
-        if (m_serverThread.joinable()) {
-            try {
-                m_serverThread.join();
-            } catch (...) {
-                // If join fails, detach as last resort to avoid hanging
-                m_serverThread.detach();
-            }
+        try {
+            m_serverThread.join();
+        } catch (...) {
+            // If join fails, detach as last resort to avoid hanging
+            m_serverThread.detach();
         }
     }
     
@@ -356,7 +440,7 @@ void WebViewWindow::navigateToFile(const std::string& htmlPath) {
     m_uiDirectory = htmlFilePath.parent_path().string();
     
     if (m_webview && m_serverPort > 0) {
-        std::string url = "http://localhost:" + std::to_string(m_serverPort) + "/";
+        std::string url = "http://127.0.0.1:" + std::to_string(m_serverPort) + "/";
         webview_navigate(m_webview, url.c_str());
     }
 }
@@ -366,34 +450,52 @@ void WebViewWindow::postMessage(const std::string& message) {
         return;
     }
     
-    // The message is already valid JSON, we need to escape it for embedding in JavaScript
-    // Escape backslashes and quotes for embedding in JavaScript string literal
-    std::string escaped;
-    for (char c : message) {
-        if (c == '\\') {
-            escaped += "\\\\";
-        } else if (c == '"') {
-            escaped += "\\\"";
-        } else if (c == '\n') {
-            escaped += "\\n";
-        } else if (c == '\r') {
-            escaped += "\\r";
-        } else if (c == '\t') {
-            escaped += "\\t";
-        } else {
-            escaped += c;
+    // Messages posted before the UI thread gets to the pending flush ride along with it
+    bool scheduleFlush = false;
+    {
+        std::lock_guard<std::mutex> lock(m_outgoingMutex);
+        if (!m_outgoing.empty()) {
+            m_outgoing += ',';
         }
+        m_outgoing += message;
+        scheduleFlush = !m_flushScheduled;
+        m_flushScheduled = true;
     }
     
-    // Create copies of the scripts for the dispatch callback
-    // We need to allocate memory that will persist until the callback executes
-    std::string* script1Ptr = new std::string("try { var msg = JSON.parse(\"" + escaped + "\"); window.dispatchEvent(new MessageEvent('message', { data: msg })); } catch(e) { console.error('Error in postMessage:', e); }");
-    std::string* script2Ptr = new std::string("try { if (typeof window.receiveMessage === 'function') { window.receiveMessage(\"" + escaped + "\"); } } catch(e) { console.error('Error in receiveMessage:', e); }");
+    if (scheduleFlush) {
+        // webview_dispatch runs the flush on the UI thread; this is only reached while it runs
+        webview_dispatch(m_webview, flushOutgoingCallback, this);
+    }
+}
+
+void WebViewWindow::flushOutgoingCallback(webview_t w, void* arg) {
+    WebViewWindow* instance = static_cast<WebViewWindow*>(arg);
+    std::string batch;
+    {
+        std::lock_guard<std::mutex> lock(instance->m_outgoingMutex);
+        batch.swap(instance->m_outgoing);
+        instance->m_flushScheduled = false;
+    }
+    if (batch.empty() || !w) {
+        return;
+    }
     
-    // Use webview_dispatch to safely call webview_eval from any thread
-    // This ensures the evaluation happens on the main/GUI thread
-    webview_dispatch(m_webview, evalScriptCallback, script1Ptr);
-    webview_dispatch(m_webview, evalScriptCallback, script2Ptr);
+    // The messages are JSON, which embeds as a JavaScript array literal as-is. U+2028/U+2029 are
+    // escaped for engines that predate them being legal in string literals.
+    std::string script;
+    script.reserve(batch.size() + 96);
+    script += "if (typeof window.receiveMessages === 'function') { window.receiveMessages([";
+    for (size_t i = 0; i < batch.size(); i++) {
+        if (batch[i] == '\xE2' && i + 2 < batch.size() && batch[i + 1] == '\x80' &&
+            (batch[i + 2] == '\xA8' || batch[i + 2] == '\xA9')) {
+            script += (batch[i + 2] == '\xA8') ? "\\u2028" : "\\u2029";
+            i += 2;
+        } else {
+            script += batch[i];
+        }
+    }
+    script += "]); }";
+    webview_eval(w, script.c_str());
 }
 
 void WebViewWindow::setMessageHandler(std::function<void(const std::string&)> handler) {
@@ -419,7 +521,16 @@ void WebViewWindow::shutdown() {
     // Stop message handler first to prevent callbacks during shutdown
     m_messageHandler = nullptr;
     
-    if (m_webview) {
+    if (m_uiThread.joinable()) {
+        // Opened with openAsync: stop its loop and let the UI thread destroy the webview
+        {
+            std::lock_guard<std::mutex> lock(m_uiLoopMutex);
+            if (m_uiLoopRunning && m_webview) {
+                webview_terminate(m_webview); // Safe from any thread
+            }
+        }
+        m_uiThread.join();
+    } else if (m_webview) {
         try {
             webview_destroy(m_webview);
         } catch (...) {
@@ -472,6 +583,14 @@ void WebViewWindow::hideWindow() {
     // The window would need to be handled differently
 }
 
+bool WebViewWindow::canHideWindow() {
+    #ifdef _WIN32
+    return true;
+    #else
+    return false;
+    #endif
+}
+
 void WebViewWindow::showWindow() {
     if (!m_webview || !m_initialized) {
         return;
@@ -2,7 +2,9 @@
 
 #include <string>
 #include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <atomic>
 
@@ -38,17 +40,29 @@ public:
     ~WebViewWindow();
     
     bool initialize(void* parentHwnd, const std::string& htmlPath);
+    
+    // Create the window on a UI thread of its own and run its message loop there, so the caller
+    // never waits for the server or the browser engine. onCreated runs on that thread with the
+    // result. On macOS (AppKit needs the main thread) this initializes inline instead.
+    // startHidden keeps the window from ever appearing (or taking focus) until showWindow();
+    // only where canHideWindow().
+    void openAsync(const std::string& htmlPath, bool startHidden, std::function<void(bool created)> onCreated);
     void navigateToFile(const std::string& htmlPath);
+    // Queue a JSON message for the page. Everything posted before the UI thread's next turn is
+    // delivered in one evaluation, as one array, to window.receiveMessages.
     void postMessage(const std::string& message);
     void setMessageHandler(std::function<void(const std::string&)> handler);
     void runMessageLoop();
     void shutdown();
     
+    int getServerPort() const { return m_serverPort; } // Picked by the OS once, then reused by later servers; 0 while down
+    
     void* getHwnd() const;
     bool isInitialized() const { return m_initialized; }
     bool isWindowValid() const;
     void hideWindow();
     void showWindow();
+    static bool canHideWindow(); // False where hideWindow/showWindow are no-ops
     
 private:
     webview_t m_webview;
@@ -57,12 +71,20 @@ private:
     std::atomic<bool> m_serverRunning;
     std::atomic<int> m_serverPort;
     std::function<void(const std::string&)> m_messageHandler;
-    bool m_initialized;
+    std::atomic<bool> m_initialized;
     std::atomic<bool> m_shuttingDown;
     std::string m_htmlPath;
     std::string m_uiDirectory;
+    std::thread m_uiThread;       // Owns the webview when opened with openAsync
+    std::mutex m_uiLoopMutex;     // Orders the loop start against shutdown's terminate
+    bool m_uiLoopRunning;
+    std::mutex m_outgoingMutex;
+    std::string m_outgoing;       // Comma separated messages awaiting the flush
+    bool m_flushScheduled;
+    void* m_hostWindow;           // Hidden window the webview is embedded in (startHidden), owned by the UI thread
     
-    void startServer();
+    std::future<int> startServer(); // Resolves to the listening port (0 on failure)
     void stopServer();
     static void messageCallback(const char* seq, const char* req, void* userData);
+    static void flushOutgoingCallback(webview_t w, void* arg);
 };
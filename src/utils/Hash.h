@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 64-bit FNV-1a. Fast and plenty for telling cached images and UI files apart,
+// not meant for anything adversarial.
+namespace Hash {
+    constexpr std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+    // Hash size bytes; pass a previous result as hash to continue it over more data
+    inline std::uint64_t fnv1a(const void* data, size_t size, std::uint64_t hash = FNV_OFFSET_BASIS) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+        return hash;
+    }
+}
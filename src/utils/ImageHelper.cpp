@@ -3,6 +3,9 @@
 #include <vector>
 #include <fstream>
 #include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #ifdef _WIN32
 #include <windows.h>
 #else
@@ -123,3 +126,109 @@ std::string ImageHelper::textureToBase64(const sf::Texture& texture) {
     return imageToBase64(image);
 }
 
+namespace {
+    // Source pixels covering each destination pixel along one axis, with their coverage
+    struct AxisWeights {
+        std::vector<unsigned int> first;  // First contributing source index
+        std::vector<unsigned int> count;  // Number of contributing source pixels
+        std::vector<size_t> offset;       // Start of this pixel's entries in weights
+        std::vector<float> weights;       // Coverage of each contributing pixel, normalized to sum to 1
+    };
+    
+    AxisWeights computeAxisWeights(unsigned int sourceLength, unsigned int targetLength) {
+        AxisWeights axis;
+        axis.first.resize(targetLength);
+        axis.count.resize(targetLength);
+        axis.offset.resize(targetLength);
+        
+        const double ratio = static_cast<double>(sourceLength) / static_cast<double>(targetLength);
+        for (unsigned int d = 0; d < targetLength; d++) {
+            double start = d * ratio;
+            double end = std::min((d + 1) * ratio, static_cast<double>(sourceLength));
+            unsigned int first = static_cast<unsigned int>(std::floor(start));
+            unsigned int last = std::min(static_cast<unsigned int>(std::ceil(end)), sourceLength);
+            
+            axis.first[d] = first;
+            axis.count[d] = last - first;
+            axis.offset[d] = axis.weights.size();
+            for (unsigned int i = first; i < last; i++) {
+                double coverage = std::min(end, i + 1.0) - std::max(start, static_cast<double>(i));
+                axis.weights.push_back(static_cast<float>(coverage / ratio));
+            }
+        }
+        return axis;
+    }
+}
+
+sf::Image ImageHelper::resizeArea(const sf::Image& source, sf::Vector2u targetSize) {
+    const sf::Vector2u sourceSize = source.getSize();
+    if (sourceSize.x == 0 || sourceSize.y == 0 || targetSize.x == 0 || targetSize.y == 0) {
+        return sf::Image();
+    }
+    if (targetSize.x > sourceSize.x || targetSize.y > sourceSize.y) {
+        return source; // Only downscaling is supported
+    }
+    
+    const AxisWeights horizontal = computeAxisWeights(sourceSize.x, targetSize.x);
+    const AxisWeights vertical = computeAxisWeights(sourceSize.y, targetSize.y);
+    const std::uint8_t* pixels = source.getPixelsPtr();
+    
+    // Premultiply once up front so both passes are plain weighted sums over 4 floats
+    // (contiguous, which lets the compiler vectorize them)
+    std::vector<float> premultiplied(static_cast<size_t>(sourceSize.x) * sourceSize.y * 4);
+    for (size_t i = 0; i < premultiplied.size(); i += 4) {
+        float alpha = pixels[i + 3] / 255.0f;
+        premultiplied[i + 0] = pixels[i + 0] * alpha;
+        premultiplied[i + 1] = pixels[i + 1] * alpha;
+        premultiplied[i + 2] = pixels[i + 2] * alpha;
+        premultiplied[i + 3] = static_cast<float>(pixels[i + 3]);
+    }
+    
+    // Horizontal pass: sourceSize.y rows of targetSize.x pixels
+    std::vector<float> rows(static_cast<size_t>(targetSize.x) * sourceSize.y * 4, 0.0f);
+    for (unsigned int y = 0; y < sourceSize.y; y++) {
+        const float* sourceRow = &premultiplied[static_cast<size_t>(y) * sourceSize.x * 4];
+        float* targetRow = &rows[static_cast<size_t>(y) * targetSize.x * 4];
+        for (unsigned int x = 0; x < targetSize.x; x++) {
+            const float* weights = &horizontal.weights[horizontal.offset[x]];
+            const float* sourcePixel = sourceRow + static_cast<size_t>(horizontal.first[x]) * 4;
+            float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (unsigned int i = 0; i < horizontal.count[x]; i++) {
+                for (int c = 0; c < 4; c++) {
+                    sum[c] += sourcePixel[i * 4 + c] * weights[i];
+                }
+            }
+            for (int c = 0; c < 4; c++) {
+                targetRow[x * 4 + c] = sum[c];
+            }
+        }
+    }
+    
+    // Vertical pass: accumulate whole rows at a time, then un-premultiply into bytes
+    std::vector<std::uint8_t> result(static_cast<size_t>(targetSize.x) * targetSize.y * 4);
+    std::vector<float> accumulator(static_cast<size_t>(targetSize.x) * 4);
+    for (unsigned int y = 0; y < targetSize.y; y++) {
+        std::fill(accumulator.begin(), accumulator.end(), 0.0f);
+        const float* weights = &vertical.weights[vertical.offset[y]];
+        for (unsigned int i = 0; i < vertical.count[y]; i++) {
+            const float* sourceRow = &rows[static_cast<size_t>(vertical.first[y] + i) * targetSize.x * 4];
+            const float weight = weights[i];
+            for (size_t j = 0; j < accumulator.size(); j++) {
+                accumulator[j] += sourceRow[j] * weight;
+            }
+        }
+        
+        std::uint8_t* targetRow = &result[static_cast<size_t>(y) * targetSize.x * 4];
+        for (unsigned int x = 0; x < targetSize.x; x++) {
+            const float* pixel = &accumulator[x * 4];
+            float alpha = pixel[3];
+            float unpremultiply = alpha > 0.0f ? 255.0f / alpha : 0.0f;
+            for (int c = 0; c < 3; c++) {
+                targetRow[x * 4 + c] = static_cast<std::uint8_t>(std::clamp(pixel[c] * unpremultiply + 0.5f, 0.0f, 255.0f));
+            }
+            targetRow[x * 4 + 3] = static_cast<std::uint8_t>(std::clamp(alpha + 0.5f, 0.0f, 255.0f));
+        }
+    }
+    
+    return sf::Image(targetSize, result.data());
+}
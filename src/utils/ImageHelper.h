@@ -13,5 +13,10 @@ public:
     
     // Convert texture to base64
     static std::string textureToBase64(const sf::Texture& texture);
+    
+    // Downscale with an area (box) filter: every source pixel contributes by the fraction
+    // of it a destination pixel covers. Color is averaged premultiplied by alpha so
+    // transparent edges don't darken. targetSize must not exceed the source size.
+    static sf::Image resizeArea(const sf::Image& source, sf::Vector2u targetSize);
 };
 
@@ -0,0 +1,226 @@
+#include "utils/JsonReader.h"
+#include <cstdlib>
+#include <cstring>
+
+JsonReader::JsonReader(std::string_view json)
+    : text(json) {
+}
+
+bool JsonReader::getString(std::string_view key, std::string& value) const {
+    std::string_view raw;
+    if (!findValue(key, raw) || raw.empty() || raw.front() != '"') {
+        return false;
+    }
+    return unescape(raw, value);
+}
+
+bool JsonReader::getNumber(std::string_view key, double& value) const {
+    std::string_view raw;
+    if (!findValue(key, raw) || raw.empty() || !(raw.front() == '-' || (raw.front() >= '0' && raw.front() <= '9'))) {
+        return false;
+    }
+    // strtod needs a terminator; numbers are short, so a stack copy does
+    char buffer[64];
+    if (raw.size() >= sizeof(buffer)) {
+        return false;
+    }
+    std::memcpy(buffer, raw.data(), raw.size());
+    buffer[raw.size()] = '\0';
+    char* end = nullptr;
+    value = std::strtod(buffer, &end);
+    return end == buffer + raw.size();
+}
+
+bool JsonReader::getBool(std::string_view key, bool& value) const {
+    std::string_view raw;
+    if (!findValue(key, raw)) {
+        return false;
+    }
+    if (raw == "true") {
+        value = true;
+        return true;
+    }
+    if (raw == "false") {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+bool JsonReader::findValue(std::string_view key, std::string_view& value) const {
+    size_t pos = skipWhitespace(text, 0);
+    if (pos >= text.size() || text[pos] != '{') {
+        return false;
+    }
+    pos = skipWhitespace(text, pos + 1);
+    if (pos < text.size() && text[pos] == '}') {
+        return false;
+    }
+    
+    while (pos < text.size()) {
+        size_t keyStart = pos;
+        if (!skipString(text, pos)) {
+            return false;
+        }
+        // Keys are compared raw; the UI never escapes characters in its keys
+        std::string_view memberKey = text.substr(keyStart + 1, pos - keyStart - 2);
+        
+        pos = skipWhitespace(text, pos);
+        if (pos >= text.size() || text[pos] != ':') {
+            return false;
+        }
+        pos = skipWhitespace(text, pos + 1);
+        size_t valueStart = pos;
+        if (!skipValue(text, pos)) {
+            return false;
+        }
+        if (memberKey == key) {
+            value = text.substr(valueStart, pos - valueStart);
+            return true;
+        }
+        
+        pos = skipWhitespace(text, pos);
+        if (pos >= text.size() || text[pos] != ',') {
+            return false; // '}' (end of the object) or malformed
+        }
+        pos = skipWhitespace(text, pos + 1);
+    }
+    return false;
+}
+
+size_t JsonReader::skipWhitespace(std::string_view json, size_t pos) {
+    while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\n' || json[pos] == '\r')) {
+        pos++;
+    }
+    return pos;
+}
+
+bool JsonReader::skipString(std::string_view json, size_t& pos) {
+    if (pos >= json.size() || json[pos] != '"') {
+        return false;
+    }
+    for (pos++; pos < json.size(); pos++) {
+        if (json[pos] == '\\') {
+            pos++;
+        } else if (json[pos] == '"') {
+            pos++;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JsonReader::skipValue(std::string_view json, size_t& pos) {
+    if (pos >= json.size()) {
+        return false;
+    }
+    char c = json[pos];
+    if (c == '"') {
+        return skipString(json, pos);
+    }
+    if (c == '{' || c == '[') {
+        // Nested value: only brackets outside strings count
+        int depth = 0;
+        while (pos < json.size()) {
+            char current = json[pos];
+            if (current == '"') {
+                if (!skipString(json, pos)) {
+                    return false;
+                }
+                continue;
+            }
+            if (current == '{' || current == '[') {
+                depth++;
+            } else if (current == '}' || current == ']') {
+                depth--;
+                if (depth == 0) {
+                    pos++;
+                    return true;
+                }
+            }
+            pos++;
+        }
+        return false;
+    }
+    // Number or literal: runs to the next delimiter
+    size_t start = pos;
+    while (pos < json.size() && json[pos] != ',' && json[pos] != '}' && json[pos] != ']' &&
+           json[pos] != ' ' && json[pos] != '\t' && json[pos] != '\n' && json[pos] != '\r') {
+        pos++;
+    }
+    return pos > start;
+}
+
+bool JsonReader::unescape(std::string_view quoted, std::string& out) {
+    out.clear();
+    std::string_view body = quoted.substr(1, quoted.size() - 2);
+    for (size_t i = 0; i < body.size(); i++) {
+        char c = body[i];
+        if (c != '\\') {
+            out += c;
+            continue;
+        }
+        if (++i >= body.size()) {
+            return false;
+        }
+        switch (body[i]) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                auto readHex = [&body](size_t at, unsigned int& code) {
+                    if (at + 4 > body.size()) {
+                        return false;
+                    }
+                    code = 0;
+                    for (size_t k = at; k < at + 4; k++) {
+                        char h = body[k];
+                        code <<= 4;
+                        if (h >= '0' && h <= '9') code |= static_cast<unsigned int>(h - '0');
+                        else if (h >= 'a' && h <= 'f') code |= static_cast<unsigned int>(h - 'a' + 10);
+                        else if (h >= 'A' && h <= 'F') code |= static_cast<unsigned int>(h - 'A' + 10);
+                        else return false;
+                    }
+                    return true;
+                };
+                unsigned int code = 0;
+                if (!readHex(i + 1, code)) {
+                    return false;
+                }
+                i += 4;
+                // Surrogate pair
+                unsigned int low = 0;
+                if (code >= 0xD800 && code <= 0xDBFF && i + 2 < body.size() && body[i + 1] == '\\' && body[i + 2] == 'u' &&
+                    readHex(i + 3, low) && low >= 0xDC00 && low <= 0xDFFF) {
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                // UTF-8
+                if (code < 0x80) {
+                    out += static_cast<char>(code);
+                } else if (code < 0x800) {
+                    out += static_cast<char>(0xC0 | (code >> 6));
+                    out += static_cast<char>(0x80 | (code & 0x3F));
+                } else if (code < 0x10000) {
+                    out += static_cast<char>(0xE0 | (code >> 12));
+                    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (code & 0x3F));
+                } else {
+                    out += static_cast<char>(0xF0 | (code >> 18));
+                    out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (code & 0x3F));
+                }
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Reads members of one flat JSON object, such as the settings UI's command messages, without
+// building a tree. Each lookup scans the text in place (nested values are skipped); nothing is
+// allocated except the strings handed back, and those reuse the caller's buffer.
+// The text must outlive the reader.
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view json);
+    
+    // False if the member is missing or has another type
+    bool getString(std::string_view key, std::string& value) const;
+    bool getNumber(std::string_view key, double& value) const;
+    bool getBool(std::string_view key, bool& value) const;
+    
+private:
+    std::string_view text;
+    
+    // Raw text of the member's value (strings keep their quotes)
+    bool findValue(std::string_view key, std::string_view& value) const;
+    
+    static size_t skipWhitespace(std::string_view json, size_t pos);
+    static bool skipString(std::string_view json, size_t& pos);
+    static bool skipValue(std::string_view json, size_t& pos);
+    static bool unescape(std::string_view quoted, std::string& out);
+};
@@ -38,11 +38,9 @@ document.addEventListener('DOMContentLoaded', () => {
     initializeUI();
     setupMessageHandlers();
 
-    // Request initial data after a short delay to ensure everything is ready
-    setTimeout(() => {
-        console.log('Requesting initial data...');
-        requestInitialData();
-    }, 100);
+    // Handlers are in place: the backend answers with the whole initial state in one message
+    console.log('UI ready, requesting initial state...');
+    sendMessage('ready');
 });
 
 function initializeUI() {
@@ -132,13 +130,12 @@ function initializeUI() {
                 state.rightArmOffset = savedRightArmOffset !== null ? savedRightArmOffset : 0;
                 state.animationVerticalOffset = savedAnimationVerticalOffset !== null ? savedAnimationVerticalOffset : 0;
                 
-                // Update sliders and send to backend
+                // Update sliders; the backend gets them with the size so they are saved for it
                 const rightArmOffsetSlider = document.getElementById('right-arm-offset-slider');
                 const rightArmOffsetValue = document.getElementById('right-arm-offset-value');
                 if (rightArmOffsetSlider && rightArmOffsetValue) {
                     rightArmOffsetSlider.value = state.rightArmOffset;
                     rightArmOffsetValue.textContent = state.rightArmOffset;
-                    sendMessage('setRightArmOffset', { offset: state.rightArmOffset });
                 }
                 
                 const animationVerticalOffsetSlider = document.getElementById('animation-vertical-offset-slider');
@@ -146,10 +143,13 @@ function initializeUI() {
                 if (animationVerticalOffsetSlider && animationVerticalOffsetValue) {
                     animationVerticalOffsetSlider.value = state.animationVerticalOffset;
                     animationVerticalOffsetValue.textContent = state.animationVerticalOffset;
-                    sendMessage('setAnimationVerticalOffset', { offset: state.animationVerticalOffset });
                 }
                 
-                sendMessage('setCatSize', { size });
+                sendMessage('setCatSize', {
+                    size,
+                    rightArmOffset: state.rightArmOffset,
+                    animationVerticalOffset: state.animationVerticalOffset
+                });
                 saveCatSizePreference();
             });
         });
@@ -432,21 +432,6 @@ function switchTab(tabName) {
     }
 }
 
-function requestInitialData() {
-    // Request initial cat pack, hat, and bonk pack
-    console.log('Requesting initial data...');
-    sendMessage('getSelectedCatPack');
-    sendMessage('getSelectedHat');
-    sendMessage('getSelectedBonkPack');
-
-    // Also request lists for current tab
-    if (state.currentTab === 'cats') {
-        requestCatPacks();
-    } else if (state.currentTab === 'hats') {
-        requestHats();
-    }
-}
-
 function requestCatPacks() {
     console.log('Requesting cat packs...');
     sendMessage('getCatPacks');
@@ -464,15 +449,12 @@ function requestBonkPacks() {
 
 
 function setupMessageHandlers() {
-    // Handle messages from C++ backend via MessageEvent
-    window.addEventListener('message', (event) => {
-        console.log('Received MessageEvent:', event);
-        if (event.data) {
-            handleMessage(event.data);
-        }
-    });
+    // The C++ backend delivers everything it queued since its last flush as one array of message objects
+    window.receiveMessages = function (messages) {
+        messages.forEach(message => handleMessage(message));
+    };
 
-    // Also set up a global function that C++ can call directly
+    // Single message, object or JSON string
     window.receiveMessage = function (message) {
         console.log('Received message via receiveMessage:', message);
         if (typeof message === 'string') {
@@ -510,6 +492,12 @@ function handleMessage(message) {
     console.log('Received message:', type, data);
 
     switch (type) {
+        case 'initialState':
+            // Batch of regular messages sent once the page reports ready
+            if (Array.isArray(data)) {
+                data.forEach(entry => handleMessage(entry));
+            }
+            break;
         case 'catPackList':
             // Data should be an array directly
             const catPacks = Array.isArray(data) ? data : [];